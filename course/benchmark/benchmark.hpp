@@ -0,0 +1,55 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace ekumen {
+
+namespace math {
+
+namespace benchmark {
+
+// Keeps the optimizer from discarding results that are otherwise unused.
+template <typename T>
+void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Calls function(i) iterations times and returns the mean nanoseconds per
+// call, after one untimed warm up pass.
+template <typename Function>
+double nanosecondsPerCall(Function function, std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    function(i);
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    function(i);
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         static_cast<double>(iterations);
+}
+
+inline void report(const std::string& name, double nanoseconds) {
+  std::cout << std::left << std::setw(40) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(2)
+            << nanoseconds << " ns" << std::endl;
+}
+
+}  // namespace benchmark
+
+}  // namespace math
+
+}  // namespace ekumen
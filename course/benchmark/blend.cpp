@@ -0,0 +1,78 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <random>
+#include <vector>
+
+#include <isometry/dual_quaternion.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::DualQuaternion;
+using ekumen::math::Isometry;
+using ekumen::math::Matrix3;
+using ekumen::math::Renormalization;
+using ekumen::math::Vector3;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+// Blends kInfluences poses per point, as in skinning.
+const std::size_t kInfluences = 4;
+
+int main() {
+  const std::size_t kCount = 100000;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  std::vector<Isometry> isometries;
+  std::vector<DualQuaternion> dual_quaternions;
+  std::vector<double> weights;
+  std::vector<Vector3> points;
+  for (std::size_t i = 0; i < kCount + kInfluences; ++i) {
+    const Isometry isometry(
+        Vector3(distribution(generator), distribution(generator),
+                distribution(generator)),
+        Isometry::fromEulerAngles(distribution(generator),
+                                  distribution(generator),
+                                  distribution(generator)).rotation());
+    isometries.push_back(isometry);
+    dual_quaternions.emplace_back(isometry);
+    weights.push_back(1.0 / kInfluences);
+    points.push_back(isometry.translation());
+  }
+  std::vector<Vector3> results(kCount);
+
+  report("dual quaternion blend + transform", nanosecondsPerCall(
+      [&](std::size_t i) {
+    results[i] = DualQuaternion::blend(&dual_quaternions[i], &weights[i],
+                                       kInfluences) * points[i];
+  }, kCount));
+  report("matrix blend + transform (not rigid)", nanosecondsPerCall(
+      [&](std::size_t i) {
+    Matrix3 rotation;
+    Vector3 translation;
+    for (std::size_t k = 0; k < kInfluences; ++k) {
+      rotation += isometries[i + k].rotation() * weights[i + k];
+      translation += isometries[i + k].translation() * weights[i + k];
+    }
+    results[i] = rotation * points[i] + translation;
+  }, kCount));
+  report("matrix blend + exact renormalization", nanosecondsPerCall(
+      [&](std::size_t i) {
+    Matrix3 rotation;
+    Vector3 translation;
+    for (std::size_t k = 0; k < kInfluences; ++k) {
+      rotation += isometries[i + k].rotation() * weights[i + k];
+      translation += isometries[i + k].translation() * weights[i + k];
+    }
+    rotation.renormalize(Renormalization::kExact);
+    results[i] = rotation * points[i] + translation;
+  }, kCount));
+  doNotOptimize(results);
+  return 0;
+}
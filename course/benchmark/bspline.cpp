@@ -0,0 +1,57 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <random>
+#include <vector>
+
+#include <isometry/bspline.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::CubicBSplineTrajectory;
+using ekumen::math::Isometry;
+using ekumen::math::Twist;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  // A 0.1 s lidar sweep deskewed against a 100 Hz spline, one timestamp
+  // per point.
+  const std::size_t kCount = 100000;
+  std::vector<Isometry> controls;
+  for (int k = 0; k < 14; ++k) {
+    controls.push_back(Isometry::fromTranslation({0.1 * k, 0.01 * k, 0.}) *
+                       Isometry::fromEulerAngles(0., 0.01 * k, 0.02 * k));
+  }
+  const CubicBSplineTrajectory spline(controls.data(), controls.size(), 0.,
+                                      0.01);
+  std::vector<double> times(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    times[i] = spline.endTime() * i / kCount;
+  }
+  std::vector<Isometry> poses(kCount);
+  std::vector<Twist> velocities(kCount);
+
+  report("evaluate", nanosecondsPerCall([&](std::size_t i) {
+    poses[i] = spline.evaluate(times[i]);
+  }, kCount));
+  report("evaluate with velocity", nanosecondsPerCall([&](std::size_t i) {
+    poses[i] = spline.evaluate(times[i], &velocities[i]);
+  }, kCount));
+  report("batched evaluate", nanosecondsPerCall([&](std::size_t) {
+    spline.evaluate(times.data(), poses.data(), kCount);
+  }, 10) / kCount);
+  report("batched evaluate with velocity",
+         nanosecondsPerCall([&](std::size_t) {
+    spline.evaluate(times.data(), poses.data(), kCount, velocities.data());
+  }, 10) / kCount);
+  doNotOptimize(poses);
+  doNotOptimize(velocities);
+  return 0;
+}
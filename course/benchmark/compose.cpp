@@ -0,0 +1,130 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <random>
+#include <vector>
+
+#include <isometry/compose.hpp>
+#include <isometry/isometry.hpp>
+#include <isometry/isometry2.hpp>
+#include <isometry/lazy.hpp>
+#include <isometry/quaternion.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::Isometry;
+using ekumen::math::Isometry2;
+using ekumen::math::QuaternionIsometry;
+using ekumen::math::Vector2;
+using ekumen::math::Vector3;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  const std::size_t kCount = 100000;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-3.0, 3.0);
+  std::vector<Isometry> isometries;
+  std::vector<QuaternionIsometry> quaternions;
+  std::vector<Vector3> points;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    const Vector3 translation(distribution(generator), distribution(generator),
+                              distribution(generator));
+    const Isometry isometry(translation, Isometry::fromEulerAngles(
+        distribution(generator), distribution(generator),
+        distribution(generator)).rotation());
+    isometries.push_back(isometry);
+    quaternions.emplace_back(isometry);
+    points.push_back(translation);
+  }
+  std::vector<Isometry2> planar;
+  std::vector<Vector2> planar_points;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    planar.emplace_back(points[i].x(), points[i].y(), points[i].z());
+    planar_points.emplace_back(points[i].y(), points[i].z());
+  }
+  std::vector<Isometry2> composed_planar(kCount);
+  std::vector<Vector2> transformed_planar(kCount);
+  std::vector<Isometry> composed(kCount);
+  std::vector<QuaternionIsometry> composed_quaternions(kCount);
+  std::vector<Vector3> transformed(kCount);
+
+  report("Isometry compose", nanosecondsPerCall([&](std::size_t i) {
+    composed[i] = isometries[i] * isometries[kCount - 1 - i];
+  }, kCount));
+  report("QuaternionIsometry compose", nanosecondsPerCall([&](std::size_t i) {
+    composed_quaternions[i] = quaternions[i] * quaternions[kCount - 1 - i];
+  }, kCount));
+  report("Isometry transform", nanosecondsPerCall([&](std::size_t i) {
+    transformed[i] = isometries[i] * points[i];
+  }, kCount));
+  report("QuaternionIsometry transform", nanosecondsPerCall([&](std::size_t i) {
+    transformed[i] = quaternions[i] * points[i];
+  }, kCount));
+  report("Isometry2 compose", nanosecondsPerCall([&](std::size_t i) {
+    composed_planar[i] = planar[i] * planar[kCount - 1 - i];
+  }, kCount));
+  report("Isometry2 transform", nanosecondsPerCall([&](std::size_t i) {
+    transformed_planar[i] = planar[i] * planar_points[i];
+  }, kCount));
+  report("t1 * t2 * point", nanosecondsPerCall([&](std::size_t i) {
+    transformed[i] = isometries[i] * isometries[kCount - 1 - i] * points[i];
+  }, kCount));
+  report("lazy(t1) * t2 * point", nanosecondsPerCall([&](std::size_t i) {
+    transformed[i] = ekumen::math::lazy(isometries[i]) *
+                     isometries[kCount - 1 - i] * points[i];
+  }, kCount));
+  report("lazy(t1) * t2 * t3, 64 points", nanosecondsPerCall(
+      [&](std::size_t i) {
+    const std::size_t offset = i % (kCount - 64);
+    (ekumen::math::lazy(isometries[i]) * isometries[kCount - 1 - i] *
+     isometries[offset]).transform(&points[offset], &transformed[offset], 64);
+  }, kCount / 10));
+  report("fromEulerAngles", nanosecondsPerCall([&](std::size_t i) {
+    composed[i] = Isometry::fromEulerAngles(points[i].x(), points[i].y(),
+                                            points[i].z());
+  }, kCount));
+  report("rotateAround X * Y * Z", nanosecondsPerCall([&](std::size_t i) {
+    composed[i] = Isometry::rotateAround(Vector3::kUnitX, points[i].x()) *
+                  Isometry::rotateAround(Vector3::kUnitY, points[i].y()) *
+                  Isometry::rotateAround(Vector3::kUnitZ, points[i].z());
+  }, kCount));
+  report("fromEulerAngles batch, per triplet", nanosecondsPerCall(
+      [&](std::size_t) {
+    Isometry::fromEulerAngles(points.data(), composed.data(), kCount);
+  }, 10) / kCount);
+  Isometry chain;
+  report("sequential chain, per element", nanosecondsPerCall(
+      [&](std::size_t) {
+    chain = Isometry::kIdentity;
+    for (const Isometry& isometry : isometries) {
+      chain *= isometry;
+    }
+  }, 10) / kCount);
+  report("composeRange, per element", nanosecondsPerCall([&](std::size_t) {
+    chain = ekumen::math::composeRange(isometries.begin(), isometries.end());
+  }, 10) / kCount);
+  report("composeRange 4 threads, per element", nanosecondsPerCall(
+      [&](std::size_t) {
+    chain = ekumen::math::composeRange(isometries.begin(), isometries.end(),
+                                       4);
+  }, 10) / kCount);
+  report("composePrefix 4 threads, per element", nanosecondsPerCall(
+      [&](std::size_t) {
+    ekumen::math::composePrefix(isometries.begin(), isometries.end(),
+                                composed.begin(), 4);
+  }, 10) / kCount);
+  doNotOptimize(chain);
+  doNotOptimize(composed);
+  doNotOptimize(composed_planar);
+  doNotOptimize(transformed_planar);
+  doNotOptimize(composed_quaternions);
+  doNotOptimize(transformed);
+  return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <isometry/decimation.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::Isometry;
+using ekumen::math::StampedIsometry;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  // Twenty minutes of 1 kHz poses from a smooth path with sensor noise.
+  const std::size_t kCount = 1200000;
+  std::mt19937 generator(42);
+  std::normal_distribution<double> noise(0.0, 1e-4);
+  std::vector<StampedIsometry> samples;
+  samples.reserve(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    const double stamp = 1e-3 * i;
+    samples.push_back(
+        {stamp, Isometry::fromTranslation({std::sin(0.1 * stamp) * 50.0 +
+                                               noise(generator),
+                                           std::cos(0.07 * stamp) * 30.0,
+                                           0.01 * stamp}) *
+                    Isometry::fromEulerAngles(noise(generator),
+                                              noise(generator),
+                                              0.1 * stamp)});
+  }
+  std::vector<std::size_t> kept;
+  report("decimate, per pose", nanosecondsPerCall([&](std::size_t) {
+    kept = ekumen::math::decimate(samples.data(), kCount, 1e-2, 1e-2);
+  }, 1) / kCount);
+  std::cout << "kept " << kept.size() << " of " << kCount << std::endl;
+  doNotOptimize(kept);
+  return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <isometry/frame_tree.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::FrameTree;
+using ekumen::math::Isometry;
+using ekumen::math::Vector3;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  // Two arms of six links each hanging from a base, plus a few sensors.
+  const std::size_t kCount = 100000;
+  FrameTree tree("map");
+  tree.addFrame("odom", "map", Isometry::fromTranslation({1., 2., 0.}));
+  tree.addFrame("base", "odom", Isometry::rotateAround(Vector3::kUnitZ, 0.3));
+  for (const std::string arm : {"left", "right"}) {
+    std::string parent = "base";
+    for (int link = 0; link < 6; ++link) {
+      const std::string frame = arm + "_link" + std::to_string(link);
+      tree.addFrame(frame, parent,
+                    Isometry::fromTranslation({0.1, 0., 0.2}) *
+                        Isometry::rotateAround(Vector3::kUnitY, 0.2));
+      parent = frame;
+    }
+  }
+  tree.addFrame("lidar", "base", Isometry::fromTranslation({0., 0., 1.}));
+  std::vector<Isometry> results(kCount);
+
+  report("lookup sibling", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = tree.lookup("base", "lidar");
+  }, kCount));
+  report("lookup arm to arm", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = tree.lookup("left_link5", "right_link5");
+  }, kCount));
+  report("lookup map to arm", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = tree.lookup("map", "left_link5");
+  }, kCount));
+  // Same lookups through handles resolved once.
+  const ekumen::math::FrameId map = tree.id("map");
+  const ekumen::math::FrameId base = tree.id("base");
+  const ekumen::math::FrameId lidar = tree.id("lidar");
+  const ekumen::math::FrameId left = tree.id("left_link5");
+  const ekumen::math::FrameId right = tree.id("right_link5");
+  report("lookup sibling, ids", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = tree.lookup(base, lidar);
+  }, kCount));
+  report("lookup arm to arm, ids", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = tree.lookup(left, right);
+  }, kCount));
+  report("lookup map to arm, ids", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = tree.lookup(map, left);
+  }, kCount));
+  report("cached lookup arm to arm", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = tree.cachedLookup(left, right);
+  }, kCount));
+  report("cached lookup arm to arm, reversed",
+         nanosecondsPerCall([&](std::size_t i) {
+    results[i] = tree.cachedLookup(right, left);
+  }, kCount));
+
+  // Lookups missing the cache, and hitting it while another edge moves.
+  report("cached lookup arm to arm, arm moving",
+         nanosecondsPerCall([&](std::size_t i) {
+    tree.setTransform("right_link3", Isometry::rotateAround(Vector3::kUnitY,
+                                                            1e-6 * i));
+    results[i] = tree.cachedLookup(left, right);
+  }, kCount));
+  report("cached lookup map to arm, other arm moving",
+         nanosecondsPerCall([&](std::size_t i) {
+    tree.setTransform("right_link3", Isometry::rotateAround(Vector3::kUnitY,
+                                                            1e-6 * i));
+    results[i] = tree.cachedLookup(map, left);
+  }, kCount));
+  std::cout << "hit rate " << tree.cacheHitRate() << std::endl;
+  doNotOptimize(results);
+  return 0;
+}
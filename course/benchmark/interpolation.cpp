@@ -0,0 +1,51 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <vector>
+
+#include <isometry/interpolation.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::Interpolation;
+using ekumen::math::Isometry;
+using ekumen::math::IsometryInterpolator;
+using ekumen::math::Vector3;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  // One scan worth of timestamps between two poses 0.05 rad apart.
+  const std::size_t kCount = 100000;
+  const Isometry start{Isometry::fromTranslation({1., 2., 3.}) *
+                       Isometry::rotateAround({1., 1., 0.}, 0.3)};
+  const Isometry end{start * Isometry::fromTranslation({0.1, 0., 0.02}) *
+                     Isometry::rotateAround({0., 1., 2.}, 0.05)};
+  std::vector<double> ts(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    ts[i] = static_cast<double>(i) / kCount;
+  }
+  std::vector<Isometry> results(kCount);
+
+  report("interpolate kSlerp", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = ekumen::math::interpolate(start, end, ts[i]);
+  }, kCount));
+  const Interpolation modes[] = {Interpolation::kScrew, Interpolation::kSlerp,
+                                 Interpolation::kNlerp};
+  const char* names[] = {"batched kScrew", "batched kSlerp",
+                         "batched kNlerp"};
+  for (int mode = 0; mode < 3; ++mode) {
+    const IsometryInterpolator interpolator(start, end, modes[mode]);
+    report(names[mode], nanosecondsPerCall([&](std::size_t) {
+      interpolator.evaluate(ts.data(), results.data(), kCount);
+    }, 10) / kCount);
+  }
+  doNotOptimize(results);
+  return 0;
+}
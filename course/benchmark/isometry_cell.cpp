@@ -0,0 +1,98 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <isometry/isometry_cell.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::Isometry;
+using ekumen::math::IsometryCell;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::report;
+
+namespace {
+
+// The baseline the cell replaces.
+class MutexCell {
+ public:
+  void store(const Isometry& isometry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    isometry_ = isometry;
+  }
+
+  Isometry load() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return isometry_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  Isometry isometry_;
+};
+
+// One writer storing back to back while kReaders threads time each load.
+// Reports the median, 99th percentile and worst load latency.
+template <typename Cell>
+void run(const std::string& name) {
+  const int kReaders = 12;
+  const std::size_t kLoads = 20000;
+  Cell cell;
+  std::atomic<bool> done{false};
+  std::thread writer([&]() {
+    const Isometry pose = Isometry::fromTranslation({1., 2., 3.});
+    while (!done.load(std::memory_order_relaxed)) {
+      cell.store(pose);
+    }
+  });
+  std::vector<std::vector<double>> latencies(kReaders);
+  std::vector<std::thread> readers;
+  for (int reader = 0; reader < kReaders; ++reader) {
+    readers.emplace_back([&, reader]() {
+      std::vector<double>& samples = latencies[reader];
+      samples.reserve(kLoads);
+      for (std::size_t i = 0; i < kLoads; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const Isometry pose = cell.load();
+        const auto stop = std::chrono::steady_clock::now();
+        doNotOptimize(pose);
+        samples.push_back(
+            std::chrono::duration<double, std::nano>(stop - start).count());
+      }
+    });
+  }
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  done.store(true);
+  writer.join();
+
+  std::vector<double> all;
+  for (const std::vector<double>& samples : latencies) {
+    all.insert(all.end(), samples.begin(), samples.end());
+  }
+  std::sort(all.begin(), all.end());
+  report(name + " load p50", all[all.size() / 2]);
+  report(name + " load p99", all[all.size() * 99 / 100]);
+  report(name + " load max", all.back());
+}
+
+}  // namespace
+
+int main() {
+  run<IsometryCell>("IsometryCell");
+  run<MutexCell>("std::mutex");
+  return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <random>
+#include <vector>
+
+#include <isometry/lie.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::Isometry;
+using ekumen::math::Twist;
+using ekumen::math::Vector3;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  const std::size_t kCount = 100000;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  std::vector<Twist> twists;
+  std::vector<Twist> small_twists;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    const Twist twist{Vector3(distribution(generator),
+                              distribution(generator),
+                              distribution(generator)),
+                      Vector3(distribution(generator),
+                              distribution(generator),
+                              distribution(generator))};
+    twists.push_back(twist);
+    small_twists.push_back(twist * 1e-3);
+  }
+  std::vector<Isometry> isometries(kCount);
+  std::vector<Isometry> small_isometries(kCount);
+  ekumen::math::expSE3(twists.data(), isometries.data(), kCount);
+  ekumen::math::expSE3(small_twists.data(), small_isometries.data(), kCount);
+  std::vector<Twist> logs(kCount);
+
+  report("expSE3", nanosecondsPerCall([&](std::size_t i) {
+    isometries[i] = ekumen::math::expSE3(twists[i]);
+  }, kCount));
+  report("expSE3 small angle", nanosecondsPerCall([&](std::size_t i) {
+    small_isometries[i] = ekumen::math::expSE3(small_twists[i]);
+  }, kCount));
+  report("logSE3", nanosecondsPerCall([&](std::size_t i) {
+    logs[i] = ekumen::math::logSE3(isometries[i]);
+  }, kCount));
+  report("logSE3 small angle", nanosecondsPerCall([&](std::size_t i) {
+    logs[i] = ekumen::math::logSE3(small_isometries[i]);
+  }, kCount));
+  doNotOptimize(isometries);
+  doNotOptimize(small_isometries);
+  doNotOptimize(logs);
+  return 0;
+}
@@ -0,0 +1,50 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <random>
+#include <vector>
+
+#include <isometry/svd.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::Matrix3;
+using ekumen::math::SVD3;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  const std::size_t kCount = 100000;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  std::vector<Matrix3> matrices(kCount);
+  for (Matrix3& matrix : matrices) {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        matrix[i][j] = distribution(generator);
+      }
+    }
+  }
+  std::vector<SVD3> results(kCount);
+
+  report("svd (fixed iterations)", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = ekumen::math::svd(matrices[i]);
+  }, kCount));
+  report("jacobiSvd (until convergence)", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = ekumen::math::jacobiSvd(matrices[i]);
+  }, kCount));
+  report("svd batch, per matrix", nanosecondsPerCall([&](std::size_t) {
+    ekumen::math::svd(matrices.data(), results.data(), kCount);
+  }, 10) / kCount);
+  report("nearestRotation", nanosecondsPerCall([&](std::size_t i) {
+    results[i].u = ekumen::math::nearestRotation(matrices[i]);
+  }, kCount));
+  doNotOptimize(results);
+  return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <isometry/transform.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::Isometry;
+using ekumen::math::SoAPoints;
+using ekumen::math::StridedPoints;
+using ekumen::math::Vector3;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  const std::size_t kCount = 1 << 22;
+  const std::size_t kThreads =
+      std::max(1u, std::thread::hardware_concurrency());
+  const Isometry isometry(Vector3(1.0, -2.0, 0.5),
+                          Isometry::fromEulerAngles(0.3, -0.2, 1.1).rotation());
+  std::vector<Vector3> points(kCount, Vector3(1.0, 2.0, 3.0));
+  std::vector<Vector3> results(kCount);
+  std::vector<double> xs(kCount, 1.0);
+  std::vector<double> ys(kCount, 2.0);
+  std::vector<double> zs(kCount, 3.0);
+
+  report("Isometry * point loop, per point", nanosecondsPerCall(
+      [&](std::size_t) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      results[i] = isometry * points[i];
+    }
+  }, 5) / kCount);
+  report("transform Vector3, per point", nanosecondsPerCall([&](std::size_t) {
+    ekumen::math::transform(isometry, points.data(), results.data(), kCount);
+  }, 5) / kCount);
+  report("transformInPlace strided, per point", nanosecondsPerCall(
+      [&](std::size_t) {
+    ekumen::math::transformInPlace(
+        isometry, StridedPoints<double>{&results[0][0], kCount,
+                                        sizeof(Vector3)});
+  }, 5) / kCount);
+  report("transformInPlace SoA, per point", nanosecondsPerCall(
+      [&](std::size_t) {
+    ekumen::math::transformInPlace(
+        isometry, SoAPoints<double>{xs.data(), ys.data(), zs.data(), kCount});
+  }, 5) / kCount);
+  report("Isometry::inverse() * point, per point", nanosecondsPerCall(
+      [&](std::size_t) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      results[i] = isometry.inverse() * points[i];
+    }
+  }, 5) / kCount);
+  report("Isometry::inverseTransform, per point", nanosecondsPerCall(
+      [&](std::size_t) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      results[i] = isometry.inverseTransform(points[i]);
+    }
+  }, 5) / kCount);
+  report("inverseTransform Vector3, per point", nanosecondsPerCall(
+      [&](std::size_t) {
+    ekumen::math::inverseTransform(isometry, points.data(), results.data(),
+                                   kCount);
+  }, 5) / kCount);
+  report("transform Vector3 all threads, per point", nanosecondsPerCall(
+      [&](std::size_t) {
+    ekumen::math::transform(isometry, points.data(), results.data(), kCount,
+                            kThreads);
+  }, 5) / kCount);
+  doNotOptimize(results);
+  doNotOptimize(xs);
+  return 0;
+}
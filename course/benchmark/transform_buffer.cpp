@@ -0,0 +1,74 @@
+/*
+ * Isometry library benchmarks
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <isometry/transform_buffer.hpp>
+
+#include "benchmark.hpp"
+
+using ekumen::math::Isometry;
+using ekumen::math::TransformBuffer;
+using ekumen::math::Vector3;
+using ekumen::math::benchmark::doNotOptimize;
+using ekumen::math::benchmark::nanosecondsPerCall;
+using ekumen::math::benchmark::report;
+
+int main() {
+  // Ten seconds of 1 kHz odometry.
+  const std::size_t kSamples = 10000;
+  const std::size_t kCount = 100000;
+  TransformBuffer buffer(kSamples);
+  double stamp = 0.;
+  report("insert", nanosecondsPerCall([&](std::size_t) {
+    stamp += 1e-3;
+    buffer.insert(stamp, Isometry::fromTranslation({stamp, 0., 0.}));
+  }, kCount));
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(
+      buffer.oldest().stamp, buffer.newest().stamp);
+  std::vector<double> stamps(kCount);
+  for (double& query : stamps) {
+    query = distribution(generator);
+  }
+  std::vector<Isometry> results(kCount);
+  report("lookup", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = buffer.lookup(stamps[i]);
+  }, kCount));
+  // Sorted stamps, as the points of a scan.
+  std::sort(stamps.begin(), stamps.end());
+  report("lookup sorted", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = buffer.lookup(stamps[i]);
+  }, kCount));
+  report("batched lookup sorted", nanosecondsPerCall([&](std::size_t) {
+    buffer.lookup(stamps.data(), results.data(), kCount);
+  }, 10) / kCount);
+  const std::vector<Vector3> points(kCount, Vector3(1., 2., 3.));
+  std::vector<Vector3> transformed(kCount);
+  report("batched transform sorted", nanosecondsPerCall([&](std::size_t) {
+    buffer.transform(stamps.data(), points.data(), transformed.data(),
+                     kCount);
+  }, 10) / kCount);
+  doNotOptimize(transformed);
+
+  // A few ms of latency compensation past the newest sample.
+  const double newest = buffer.newest().stamp;
+  report("extrapolate", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = buffer.extrapolate(newest + 1e-8 * i, 0.01);
+  }, kCount));
+  const ekumen::math::Twist velocity = buffer.velocity(0.01);
+  report("extrapolate, cached velocity", nanosecondsPerCall([&](std::size_t i) {
+    results[i] = ekumen::math::extrapolate(buffer.newest(), velocity,
+                                           newest + 1e-8 * i);
+  }, kCount));
+  doNotOptimize(results);
+  return 0;
+}
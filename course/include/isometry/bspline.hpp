@@ -0,0 +1,67 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+#include <isometry/lie.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Uniform cumulative cubic B-spline on SE(3) (Lovegrove et al., 2013).
+// Control pose k sits at start + (k - 1) * interval, and the segment in
+// [start + s * interval, start + (s + 1) * interval] is
+//   T(u) = T_s * exp(b1(u) * d_s+1) * exp(b2(u) * d_s+2) * exp(b3(u) * d_s+3)
+// with d_k = log(T_k-1^-1 * T_k), u in [0, 1] and the cumulative basis
+//   [b0 b1 b2 b3]^T = 1/6 * [6 0 0 0; 5 3 -3 1; 1 3 3 -2; 0 0 0 1] *
+//                     [1 u u^2 u^3]^T.
+// The curve is C2 but, as any B-spline, does not go through the control
+// poses. The logarithms d_k are computed once on construction.
+class CubicBSplineTrajectory {
+ public:
+  // Throws std::invalid_argument with fewer than 4 control poses or a non
+  // positive interval. Expects rotation matrices.
+  CubicBSplineTrajectory(const Isometry* control_poses,
+                         const std::size_t count, const double start,
+                         const double interval);
+
+  // The trajectory is defined in [startTime(), endTime()].
+  double startTime() const;
+  double endTime() const;
+  std::size_t segments() const;
+
+  // Throw std::out_of_range outside [startTime(), endTime()].
+  Isometry evaluate(const double time) const;
+  // Also writes the body velocity, T^-1 * dT/dt, to velocity.
+  Isometry evaluate(const double time, Twist* velocity) const;
+  // Batched evaluation of ascending times: walks the segments forward
+  // instead of locating each one. velocities may be null. Throws
+  // std::invalid_argument when times are not sorted.
+  void evaluate(const double* times, Isometry* results,
+                const std::size_t count, Twist* velocities = nullptr) const;
+
+ private:
+  // Segment holding time, and u within it.
+  std::size_t segment(const double time, double* u) const;
+  Isometry evaluate(const std::size_t segment, const double u,
+                    Twist* velocity) const;
+
+  std::vector<Isometry> control_poses_;
+  std::vector<Twist> deltas_;
+  double start_;
+  double interval_;
+};
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,131 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+#include <isometry/parallel.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Chains shorter than this per thread are composed on the calling thread,
+// since starting a thread costs more than composing them.
+constexpr std::size_t kMinParallelChain = 4096;
+
+// Returns *first * *(first + 1) * ... * *(last - 1), or Isometry::kIdentity
+// for an empty range. Products are formed as a balanced binary tree, so
+// rounding errors grow with log(n) instead of n. When threads > 1 and the
+// chain is long enough, the range is split into contiguous blocks composed
+// concurrently.
+template <typename Iterator>
+Isometry composeRange(Iterator first, Iterator last,
+                      const std::size_t threads = 1);
+
+// Writes every cumulative pose *first, *first * *(first + 1), ... to result
+// and returns the end of the written range. result must be a forward
+// iterator, e.g. into a std::vector sized for the output. With threads > 1
+// each block is scanned concurrently, starting from the product of the
+// blocks before it.
+template <typename InputIterator, typename OutputIterator>
+OutputIterator composePrefix(InputIterator first, InputIterator last,
+                             OutputIterator result,
+                             const std::size_t threads = 1);
+
+namespace internal {
+
+template <typename Iterator>
+Isometry composeTree(Iterator first, const std::size_t count) {
+  if (count == 1) {
+    return *first;
+  }
+  const std::size_t half = count / 2;
+  return composeTree(first, half) *
+         composeTree(std::next(first, half), count - half);
+}
+
+}  // namespace internal
+
+template <typename Iterator>
+Isometry composeRange(Iterator first, Iterator last,
+                      const std::size_t threads) {
+  const std::size_t count =
+      static_cast<std::size_t>(std::distance(first, last));
+  if (count == 0) {
+    return Isometry::kIdentity;
+  }
+  const std::size_t blocks = internal::parallelBlocks(count, threads,
+                                                       kMinParallelChain);
+  if (blocks == 1) {
+    return internal::composeTree(first, count);
+  }
+  std::vector<Isometry> partials(blocks);
+  internal::forEachBlock(count, blocks, [&](std::size_t block,
+                                            std::size_t begin,
+                                            std::size_t size) {
+    partials[block] = internal::composeTree(std::next(first, begin), size);
+  });
+  return internal::composeTree(partials.cbegin(), blocks);
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator composePrefix(InputIterator first, InputIterator last,
+                             OutputIterator result,
+                             const std::size_t threads) {
+  const std::size_t count =
+      static_cast<std::size_t>(std::distance(first, last));
+  if (count == 0) {
+    return result;
+  }
+  const auto scan = [&](const Isometry* offset, std::size_t begin,
+                        std::size_t size) {
+    InputIterator input = std::next(first, begin);
+    OutputIterator output = std::next(result, begin);
+    Isometry pose = offset == nullptr ? *input : *offset * *input;
+    *output = pose;
+    for (std::size_t i = 1; i < size; ++i) {
+      pose = pose * *++input;
+      *++output = pose;
+    }
+  };
+  const std::size_t blocks = internal::parallelBlocks(count, threads,
+                                                       kMinParallelChain);
+  if (blocks == 1) {
+    scan(nullptr, 0, count);
+    return std::next(result, count);
+  }
+  // Block totals first, then each block is scanned from the product of the
+  // totals before it.
+  std::vector<Isometry> offsets(blocks);
+  internal::forEachBlock(count, blocks, [&](std::size_t block,
+                                            std::size_t begin,
+                                            std::size_t size) {
+    if (block + 1 < blocks) {
+      offsets[block + 1] =
+          internal::composeTree(std::next(first, begin), size);
+    }
+  });
+  for (std::size_t block = 2; block < blocks; ++block) {
+    offsets[block] = offsets[block - 1] * offsets[block];
+  }
+  internal::forEachBlock(count, blocks, [&](std::size_t block,
+                                            std::size_t begin,
+                                            std::size_t size) {
+    scan(block == 0 ? nullptr : &offsets[block], begin, size);
+  });
+  return std::next(result, count);
+}
+
+}  // namespace math
+
+}  // namespace ekumen
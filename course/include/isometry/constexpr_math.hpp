@@ -0,0 +1,67 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+namespace ekumen {
+
+namespace math {
+
+// Trigonometry usable in constant expressions, so that rotations with fixed
+// angles fold at compile time. Results are within a few ulp of std::sin and
+// std::cos for angles of moderate magnitude; prefer the std functions at
+// runtime.
+constexpr double constexprSin(const double angle);
+constexpr double constexprCos(const double angle);
+
+namespace internal {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kTwoPi = 2.0 * kPi;
+// More terms than any angle in [-pi, pi] needs to converge.
+constexpr int kMaxSeriesTerms = 30;
+constexpr double kNegligibleTerm = 1e-20;
+
+// Maps angle into [-pi, pi].
+constexpr double reduceAngle(const double angle) {
+  return angle - kTwoPi * static_cast<double>(static_cast<long long>(
+      angle / kTwoPi + (angle >= 0.0 ? 0.5 : -0.5)));
+}
+
+// Taylor series of sin or cos from the term of order n on. Terms are added
+// from the smallest one up, once they fall below double resolution.
+constexpr double taylorSeries(const double square, const double term,
+                              const int n) {
+  return (term < kNegligibleTerm && term > -kNegligibleTerm) ||
+         n > 2 * kMaxSeriesTerms
+             ? term
+             : term + taylorSeries(square, -term * square / ((n + 1) * (n + 2)),
+                                   n + 2);
+}
+
+constexpr double sinReduced(const double angle) {
+  return taylorSeries(angle * angle, angle, 1);
+}
+
+constexpr double cosReduced(const double angle) {
+  return taylorSeries(angle * angle, 1.0, 0);
+}
+
+}  // namespace internal
+
+constexpr double constexprSin(const double angle) {
+  return internal::sinReduced(internal::reduceAngle(angle));
+}
+
+constexpr double constexprCos(const double angle) {
+  return internal::cosReduced(internal::reduceAngle(angle));
+}
+
+}  // namespace math
+
+}  // namespace ekumen
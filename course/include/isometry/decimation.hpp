@@ -0,0 +1,41 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <isometry/transform_buffer.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Douglas-Peucker decimation of a trajectory. Returns the ascending indices
+// of the samples to keep, always including the first and the last one,
+// such that every dropped sample is within translation_tolerance (meters)
+// and rotation_tolerance (radians) of the pose interpolated with
+// Interpolation::kSlerp between the kept samples around it, i.e. of what
+// TransformBuffer::lookup() gives back.
+//
+// Ranges are split at the sample with the largest error relative to the
+// tolerances, using an explicit stack rather than recursion. That is
+// O(n log n) for the usual trajectories, degrading to O(n^2) only when
+// every split peels off a single sample.
+//
+// Throws std::invalid_argument when the stamps are not strictly
+// increasing or a tolerance is negative.
+std::vector<std::size_t> decimate(const StampedIsometry* samples,
+                                  const std::size_t count,
+                                  const double translation_tolerance,
+                                  const double rotation_tolerance);
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,75 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+
+#include <isometry/isometry.hpp>
+#include <isometry/quaternion.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Dual quaternion real + e * dual, e^2 = 0. Unit dual quaternions represent
+// isometries: real is the rotation and dual = t * real / 2, t being the
+// translation as a pure quaternion. q and -q are the same isometry.
+class DualQuaternion {
+ public:
+  DualQuaternion(const Quaternion& real, const Quaternion& dual);
+  // Identity transform.
+  DualQuaternion();
+  // Expects isometry.rotation() to be a rotation matrix.
+  explicit DualQuaternion(const Isometry& isometry);
+  explicit DualQuaternion(const QuaternionIsometry& isometry);
+
+  Isometry toIsometry() const;
+  QuaternionIsometry toQuaternionIsometry() const;
+
+  const Quaternion& real() const;
+  const Quaternion& dual() const;
+  Vector3 translation() const;
+
+  // Inverse of a unit dual quaternion.
+  DualQuaternion conjugate() const;
+  // Unit real part with the dual part made orthogonal to it.
+  DualQuaternion normalized() const;
+
+  DualQuaternion compose(const DualQuaternion& dual_quaternion1) const;
+  Vector3 transform(const Vector3& vector1) const;
+
+  // Dual quaternion linear blending (Kavan et al., 2007): the weighted sum
+  // of the inputs, flipped onto the hemisphere of the first one, and
+  // normalized. The result is always rigid, unlike blended matrices.
+  // Throws std::invalid_argument when count is zero or the weights cancel.
+  static DualQuaternion blend(const DualQuaternion* dual_quaternions,
+                              const double* weights,
+                              const std::size_t count);
+
+  bool operator==(const DualQuaternion& dual_quaternion1) const;
+  bool operator!=(const DualQuaternion& dual_quaternion1) const;
+  DualQuaternion operator+(const DualQuaternion& dual_quaternion1) const;
+  DualQuaternion operator*(const DualQuaternion& dual_quaternion1) const;
+  DualQuaternion operator*(const double scalar) const;
+  Vector3 operator*(const Vector3& vector1) const;
+
+  friend DualQuaternion operator*(const double scalar,
+                                  const DualQuaternion& dual_quaternion1);
+  friend std::ostream& operator<<(std::ostream &ss,
+                                  const DualQuaternion& dual_quaternion1);
+
+ private:
+  Quaternion real_;
+  Quaternion dual_;
+};
+
+}  // namespace math
+
+}  // namespace ekumen
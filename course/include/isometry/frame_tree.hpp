@@ -0,0 +1,161 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Handle of a frame in a FrameTree. Resolve it once from the name with
+// FrameTree::id() and use it on hot paths: it indexes the frame array
+// directly, with no string hashing. Handles carry the serial number of the
+// tree that issued them, so that they are not mistaken for a frame of
+// another tree. Default constructed handles refer to no frame.
+class FrameId {
+ public:
+  constexpr FrameId();
+
+  std::size_t index() const;
+  bool valid() const;
+
+  bool operator==(const FrameId& id1) const;
+  bool operator!=(const FrameId& id1) const;
+
+ private:
+  friend class FrameTree;
+
+  constexpr FrameId(const std::size_t index, const std::uint64_t tree);
+
+  std::size_t index_;
+  // Serial of the issuing tree, zero for no tree.
+  std::uint64_t tree_;
+};
+
+constexpr FrameId::FrameId() :
+  index_{static_cast<std::size_t>(-1)}, tree_{0} {}
+
+constexpr FrameId::FrameId(const std::size_t index, const std::uint64_t tree) :
+  index_{index}, tree_{tree} {}
+
+// Tree of coordinate frames. Each frame but the root stores the transform
+// from its own coordinates into its parent's, parent_T_frame. Frames live
+// in a flat array indexed by FrameId; the overloads taking names resolve
+// them through a hash map first and are otherwise the same.
+//
+// cachedLookup() keeps composed lookups in a direct-mapped table with one
+// slot per frame of the capacity, allocated up front, with one entry for
+// both orders of a pair. Every edge keeps a version bumped by
+// setTransform(), and an entry is valid while the sum of the versions
+// along its path is unchanged, so an update only invalidates the paths
+// through that edge. Checking it walks the path adding integers instead of
+// composing isometries. Pairs mapped to the same slot evict each other.
+// lookup() does not touch the cache, so it can be called from several
+// threads at once as long as no one modifies the tree.
+//
+// Handles of other trees, or invalid ones, make the FrameId overloads
+// throw std::out_of_range, as unknown names do. Copies take a serial of
+// their own, so handles of the original must be resolved again with id().
+class FrameTree {
+ public:
+  // Reserves room for capacity frames, the root included.
+  explicit FrameTree(const std::string& root,
+                     const std::size_t capacity = 64);
+  FrameTree(const FrameTree& tree);
+  FrameTree& operator=(const FrameTree& tree);
+
+  // Adds frame under parent with parent_T_frame = transform. Throws
+  // std::invalid_argument when frame already exists and std::out_of_range
+  // when parent does not.
+  FrameId addFrame(const std::string& frame, const std::string& parent,
+                   const Isometry& transform);
+  FrameId addFrame(const std::string& frame, const FrameId parent,
+                   const Isometry& transform);
+  // Replaces parent_T_frame. Throws std::out_of_range for unknown frames
+  // and std::invalid_argument for the root.
+  void setTransform(const std::string& frame, const Isometry& transform);
+  void setTransform(const FrameId frame, const Isometry& transform);
+
+  // Throws std::out_of_range for unknown frames.
+  FrameId id(const std::string& frame) const;
+  const std::string& name(const FrameId frame) const;
+
+  const std::string& root() const;
+  std::size_t size() const;
+  bool contains(const std::string& frame) const;
+  // Throw std::out_of_range for unknown frames, and for the root.
+  FrameId parent(const FrameId frame) const;
+  const std::string& parent(const std::string& frame) const;
+  const Isometry& transform(const FrameId frame) const;
+  const Isometry& transform(const std::string& frame) const;
+
+  // target_T_source, mapping source coordinates into target ones. Walks
+  // both frames up to their lowest common ancestor and composes only the
+  // edges on the way, O(depth).
+  Isometry lookup(const FrameId target, const FrameId source) const;
+  Isometry lookup(const std::string& target, const std::string& source) const;
+  // Same as lookup(), through the cache.
+  Isometry cachedLookup(const FrameId target, const FrameId source);
+  Isometry cachedLookup(const std::string& target,
+                        const std::string& source);
+
+  // Counters of cachedLookup(), lookups of a frame into itself not
+  // included.
+  std::size_t cacheHits() const;
+  std::size_t cacheMisses() const;
+  // Hits over lookups, zero before the first one.
+  double cacheHitRate() const;
+  void resetCacheCounters();
+  void clearCache();
+
+ private:
+  static constexpr std::size_t kNoParent = static_cast<std::size_t>(-1);
+
+  struct Frame {
+    std::string name;
+    std::size_t parent;
+    std::size_t depth;
+    Isometry transform;
+    std::uint64_t version;
+  };
+
+  // first_T_second, for first < second. Empty while first is kNoParent.
+  struct CacheEntry {
+    std::size_t first;
+    std::size_t second;
+    std::uint64_t version;
+    Isometry transform;
+  };
+
+  std::size_t index(const FrameId frame) const;
+  // Index of a frame other than the root.
+  std::size_t child(const FrameId frame) const;
+  Isometry compose(std::size_t target, std::size_t source) const;
+  // Sum of the edge versions between both frames.
+  std::uint64_t version(std::size_t target, std::size_t source) const;
+
+  std::uint64_t serial_;
+  std::vector<Frame> frames_;
+  std::unordered_map<std::string, std::size_t> indices_;
+  // Power of two number of slots, indexed by a hash of the pair.
+  std::vector<CacheEntry> cache_;
+  std::size_t hits_{0};
+  std::size_t misses_{0};
+};
+
+}  // namespace math
+
+}  // namespace ekumen
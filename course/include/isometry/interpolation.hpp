@@ -0,0 +1,92 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+#include <isometry/isometry.hpp>
+#include <isometry/lie.hpp>
+#include <isometry/quaternion.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+enum class Interpolation {
+  // start * exp(t * log(start^-1 * end)): constant body twist, the
+  // translation follows a helix around the screw axis.
+  kScrew,
+  // Constant angular velocity rotation, translation along the straight line
+  // between the two translations.
+  kSlerp,
+  // As kSlerp, but the rotation is the normalized linear blend of the two
+  // quaternions. No trigonometry per evaluation; it follows the same path
+  // as kSlerp at a non uniform speed, see nlerpErrorBound().
+  kNlerp,
+};
+
+// Upper bound, in radians, of the rotation angle between kNlerp and kSlerp
+// over t in [0, 1] for poses that are angle radians apart:
+// sqrt(3) / 432 * angle^3 * (1 + angle^2 / 48). About 4e-6 rad for a
+// 0.1 rad step and 4e-3 rad for a 1 rad step.
+double nlerpErrorBound(const double angle);
+
+// Interpolates between a pair of poses, precomputing everything that does
+// not depend on t. Build one per pose pair and evaluate it for all the
+// timestamps in between. Expects both rotations to be rotation matrices.
+// t = 0 gives start and t = 1 gives end; other values extrapolate.
+class IsometryInterpolator {
+ public:
+  IsometryInterpolator(const Isometry& start, const Isometry& end,
+                       const Interpolation mode = Interpolation::kSlerp);
+
+  Interpolation mode() const;
+  // Rotation angle between start and end, in [0, pi].
+  double angle() const;
+
+  Isometry evaluate(const double t) const;
+  // results[i] = evaluate(ts[i]).
+  void evaluate(const double* ts, Isometry* results,
+                const std::size_t count) const;
+
+  // Pieces of the kSlerp pose at t, whatever the mode: the rotation as a
+  // quaternion that is not normalized, and the translation. For callers
+  // that compare rotations on quaternions, where the norm cancels out.
+  void slerpParts(const double t, Quaternion* rotation,
+                  Vector3* translation) const;
+
+ private:
+  Isometry screw(const double t) const;
+  Isometry slerp(const double t) const;
+  Isometry nlerp(const double t) const;
+  // Point on the straight line between both translations.
+  Vector3 translationAt(const double t) const;
+
+  Interpolation mode_;
+  Isometry start_;
+  // Body twist from start to end, for kScrew.
+  Twist twist_;
+  // Rotations of start and end on the same hemisphere, and half the angle
+  // between them, for kSlerp and kNlerp.
+  Quaternion start_rotation_;
+  Quaternion end_rotation_;
+  double half_angle_;
+  double sin_half_angle_;
+  Vector3 start_translation_;
+  Vector3 delta_translation_;
+};
+
+// Shorthand for IsometryInterpolator(start, end, mode).evaluate(t).
+Isometry interpolate(const Isometry& start, const Isometry& end,
+                     const double t,
+                     const Interpolation mode = Interpolation::kSlerp);
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -9,32 +9,42 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <initializer_list>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
+#include <isometry/constexpr_math.hpp>
+#include <isometry/matrixn.hpp>
+
 namespace ekumen {
 
 namespace math {
 
 class Vector3 {
  public:
-  Vector3(const double x, const double y, const double z);
-  Vector3();
+  constexpr Vector3(const double x, const double y, const double z);
+  Vector3(std::initializer_list<double> values);
+  constexpr Vector3();
+  constexpr explicit Vector3(const MatrixN<3, 1>& values);
   double norm() const;
 
-  double x() const;
-  double &x();
+  constexpr double x() const &;
+  double &x() &;
+
+  constexpr double y() const &;
+  double &y() &;
+
+  constexpr double z() const &;
+  double &z() &;
 
-  double y() const;
-  double &y();
-  
-  double z() const;
-  double &z();
+  constexpr double dot(const Vector3& vector1) const;
+  constexpr Vector3 cross(const Vector3& vector1) const;
 
-  double dot(const Vector3& vector1) const;
-  Vector3 cross(const Vector3& vector1) const;
+  // Column vector view, for use with the generic MatrixN algebra.
+  constexpr const MatrixN<3, 1>& matrix() const &;
 
   static const Vector3 kUnitX;
   static const Vector3 kUnitY;
@@ -43,8 +53,8 @@ class Vector3 {
 
   bool operator==(const Vector3& vector1) const;
   bool operator!=(const Vector3& vector1) const;
-  Vector3 operator+(const Vector3& vector1) const;
-  Vector3 operator-(const Vector3& vector1) const;
+  constexpr Vector3 operator+(const Vector3& vector1) const;
+  constexpr Vector3 operator-(const Vector3& vector1) const;
   Vector3 operator*(const Vector3& vector1) const;
   Vector3 operator/(const Vector3& vector1) const;
   Vector3 operator/(const double divider) const;
@@ -56,20 +66,338 @@ class Vector3 {
   Vector3& operator*=(const double scalar);
   Vector3& operator/=(const double scalar);
 
-  friend const Vector3 operator*(const Vector3& vector1, const int scalar);
-  friend const Vector3 operator*(const int scalar, const Vector3& vector1);
+  friend const Vector3 operator*(const Vector3& vector1, const double scalar);
+  friend const Vector3 operator*(const double scalar, const Vector3& vector1);
 
-  double operator[](int) const;
-  double &operator[](int);
+  constexpr double operator[](int) const &;
+  double &operator[](int) &;
 
   friend std::ostream& operator<<(std::ostream &ss, const Vector3& vector1);
 
  private:
-  double x_;
-  double y_;
-  double z_;
+  MatrixN<3, 1> values_;
+};
+
+constexpr Vector3::Vector3(const double x, const double y, const double z) :
+  values_(x, y, z) {}
+
+constexpr Vector3::Vector3() :
+  values_() {}
+
+constexpr Vector3::Vector3(const MatrixN<3, 1>& values) :
+  values_(values) {}
+
+constexpr double Vector3::x() const & {
+  return values_(0, 0);
+}
+
+constexpr double Vector3::y() const & {
+  return values_(1, 0);
+}
+
+constexpr double Vector3::z() const & {
+  return values_(2, 0);
+}
+
+constexpr double Vector3::dot(const Vector3& vector1) const {
+  return x()*vector1.x() + y()*vector1.y() + z()*vector1.z();
+}
+
+constexpr Vector3 Vector3::cross(const Vector3& vector1) const {
+  return Vector3(
+    y()*vector1.z() - z()*vector1.y(),
+    z()*vector1.x() - x()*vector1.z(),
+    x()*vector1.y() - y()*vector1.x());
+}
+
+constexpr const MatrixN<3, 1>& Vector3::matrix() const & {
+  return values_;
+}
+
+constexpr Vector3 Vector3::operator+(const Vector3& vector1) const {
+  return Vector3(x()+vector1.x(), y()+vector1.y(), z()+vector1.z());
+}
+
+constexpr Vector3 Vector3::operator-(const Vector3& vector1) const {
+  return Vector3(x()-vector1.x(), y()-vector1.y(), z()-vector1.z());
+}
+
+constexpr double Vector3::operator[](int index) const & {
+  return (index < 0 || index > 2) ?
+         throw std::out_of_range("Index out of range") :
+         values_(index, 0);
+}
+
+// Strategies to pull a drifted rotation matrix back onto SO(3).
+enum class Renormalization {
+  // First-order correction: splits the row 0/1 orthogonality error between
+  // both rows, rebuilds row 2 with a cross product and rescales each row
+  // with a Taylor expansion of 1 / norm. Cheap enough for every step, but
+  // only valid for small drift.
+  kFast,
+  // Nearest rotation in the Frobenius norm (polar decomposition via SVD).
+  kExact,
+};
+
+class Matrix3 {
+ public:
+  constexpr Matrix3(const double a00, const double a01, const double a02,
+                    const double a10, const double a11, const double a12,
+                    const double a20, const double a21, const double a22);
+  Matrix3(std::initializer_list<double> values);
+  constexpr Matrix3();
+  explicit Matrix3(const MatrixN<3, 3>& values);
+
+  // Right handed rotations around each axis. Being constexpr, fixed angles
+  // (e.g. sensor mounting extrinsics) fold into constants at compile time.
+  static constexpr Matrix3 rotationX(const double angle);
+  static constexpr Matrix3 rotationY(const double angle);
+  static constexpr Matrix3 rotationZ(const double angle);
+
+  constexpr Vector3 row(int index) const;
+  constexpr Vector3 col(int index) const;
+  constexpr double det() const;
+
+  // Copy as a generic MatrixN.
+  MatrixN<3, 3> matrix() const;
+
+  // Transposed copy of the matrix.
+  constexpr Matrix3 transpose() const;
+  // Matrix (row by column) product, as opposed to the element-wise operator*.
+  constexpr Matrix3 product(const Matrix3& matrix1) const;
+
+  // Inverse through the adjugate, whose first column also yields det().
+  // Throws std::domain_error when the matrix is singular, that is when
+  // |det()| <= kSingularityTolerance * max(|a_ij|)^3.
+  Matrix3 inverse() const;
+  // Non throwing inverse(): returns false and leaves result untouched when
+  // the matrix is singular.
+  bool tryInverse(Matrix3* result) const;
+  // Inverts count matrices. Singular ones get kZero and invertible[i] set to
+  // false; invertible may be null. Returns the number of inverted matrices.
+  static std::size_t tryInverse(const Matrix3* matrices, Matrix3* results,
+                                bool* invertible, const std::size_t count);
+  static const double kSingularityTolerance;
+
+  // Re-orthonormalizes the matrix in place, see Renormalization.
+  Matrix3& renormalize(const Renormalization mode = Renormalization::kFast);
+
+  static const Matrix3 kIdentity;
+  static const Matrix3 kOnes;
+  static const Matrix3 kZero;
+
+  bool operator==(const Matrix3& matrix1) const;
+  bool operator!=(const Matrix3& matrix1) const;
+  Matrix3 operator+(const Matrix3& matrix1) const;
+  Matrix3 operator-(const Matrix3& matrix1) const;
+  Matrix3 operator*(const Matrix3& matrix1) const;
+  Matrix3 operator/(const Matrix3& matrix1) const;
+  constexpr Vector3 operator*(const Vector3& vector1) const;
+
+  Matrix3& operator+=(const Matrix3& matrix1);
+  Matrix3& operator-=(const Matrix3& matrix1);
+  Matrix3& operator*=(const Matrix3& matrix1);
+  Matrix3& operator/=(const Matrix3& matrix1);
+  Matrix3& operator*=(const double scalar);
+  Matrix3& operator/=(const double scalar);
+
+  friend const Matrix3 operator*(const Matrix3& matrix1, const double scalar);
+  friend const Matrix3 operator*(const double scalar, const Matrix3& matrix1);
+
+  constexpr const Vector3& operator[](int) const &;
+  Vector3& operator[](int) &;
+
+  friend std::ostream& operator<<(std::ostream &ss, const Matrix3& matrix1);
+
+ private:
+  // Rows are dot products of rows_ with the rows of columns.
+  constexpr Matrix3 productTransposed(const Matrix3& columns) const;
+
+  Vector3 rows_[3];
+};
+
+constexpr Matrix3::Matrix3(const double a00, const double a01,
+                           const double a02, const double a10,
+                           const double a11, const double a12,
+                           const double a20, const double a21,
+                           const double a22) :
+  rows_{Vector3(a00, a01, a02),
+        Vector3(a10, a11, a12),
+        Vector3(a20, a21, a22)} {}
+
+constexpr Matrix3::Matrix3() :
+  rows_{Vector3(), Vector3(), Vector3()} {}
+
+constexpr Matrix3 Matrix3::rotationX(const double angle) {
+  return Matrix3(1.0, 0.0, 0.0,
+                 0.0, constexprCos(angle), -constexprSin(angle),
+                 0.0, constexprSin(angle), constexprCos(angle));
+}
+
+constexpr Matrix3 Matrix3::rotationY(const double angle) {
+  return Matrix3(constexprCos(angle), 0.0, constexprSin(angle),
+                 0.0, 1.0, 0.0,
+                 -constexprSin(angle), 0.0, constexprCos(angle));
+}
+
+constexpr Matrix3 Matrix3::rotationZ(const double angle) {
+  return Matrix3(constexprCos(angle), -constexprSin(angle), 0.0,
+                 constexprSin(angle), constexprCos(angle), 0.0,
+                 0.0, 0.0, 1.0);
+}
+
+constexpr const Vector3& Matrix3::operator[](int index) const & {
+  return (index < 0 || index > 2) ?
+         throw std::out_of_range("Index out of range") :
+         rows_[index];
+}
+
+constexpr Vector3 Matrix3::row(int index) const {
+  return (*this)[index];
+}
+
+constexpr Vector3 Matrix3::col(int index) const {
+  return (index < 0 || index > 2) ?
+         throw std::out_of_range("Index out of range") :
+         Vector3(rows_[0][index], rows_[1][index], rows_[2][index]);
+}
+
+constexpr double Matrix3::det() const {
+  return rows_[0].dot(rows_[1].cross(rows_[2]));
+}
+
+constexpr Matrix3 Matrix3::transpose() const {
+  return Matrix3(
+    rows_[0].x(), rows_[1].x(), rows_[2].x(),
+    rows_[0].y(), rows_[1].y(), rows_[2].y(),
+    rows_[0].z(), rows_[1].z(), rows_[2].z());
+}
+
+constexpr Matrix3 Matrix3::product(const Matrix3& matrix1) const {
+  return productTransposed(matrix1.transpose());
+}
+
+constexpr Matrix3 Matrix3::productTransposed(const Matrix3& columns) const {
+  return Matrix3(
+    rows_[0].dot(columns.rows_[0]), rows_[0].dot(columns.rows_[1]),
+    rows_[0].dot(columns.rows_[2]),
+    rows_[1].dot(columns.rows_[0]), rows_[1].dot(columns.rows_[1]),
+    rows_[1].dot(columns.rows_[2]),
+    rows_[2].dot(columns.rows_[0]), rows_[2].dot(columns.rows_[1]),
+    rows_[2].dot(columns.rows_[2]));
+}
+
+constexpr Vector3 Matrix3::operator*(const Vector3& vector1) const {
+  return Vector3(
+    rows_[0].dot(vector1),
+    rows_[1].dot(vector1),
+    rows_[2].dot(vector1));
+}
+
+class Isometry {
+ public:
+  constexpr Isometry(const Vector3& translation, const Matrix3& rotation);
+  constexpr Isometry();
+
+  static constexpr Isometry fromTranslation(const Vector3& translation);
+  static Isometry rotateAround(const Vector3& axis, const double angle);
+  // Equivalent to rotateAround(kUnitX, roll) * rotateAround(kUnitY, pitch) *
+  // rotateAround(kUnitZ, yaw).
+  static Isometry fromEulerAngles(const double roll, const double pitch,
+                                  const double yaw);
+  // Converts count (roll, pitch, yaw) triplets, e.g. from an IMU log.
+  static void fromEulerAngles(const Vector3* angles, Isometry* results,
+                              const std::size_t count);
+
+  constexpr const Vector3& translation() const;
+  constexpr const Matrix3& rotation() const;
+
+  constexpr Vector3 transform(const Vector3& vector1) const;
+  // Same as inverse() * vector1, R^T * (vector1 - t), without building the
+  // inverse.
+  constexpr Vector3 inverseTransform(const Vector3& vector1) const;
+  Isometry inverse() const;
+  // 4x4 homogeneous matrix [R t; 0 1].
+  Matrix4 matrix() const;
+  Isometry compose(const Isometry& isometry1) const;
+
+  // Re-orthonormalizes the rotation part in place, see Renormalization.
+  Isometry& renormalize(const Renormalization mode = Renormalization::kFast);
+
+  static const Isometry kIdentity;
+
+  bool operator==(const Isometry& isometry1) const;
+  bool operator!=(const Isometry& isometry1) const;
+  Isometry operator*(const Isometry& isometry1) const;
+  Vector3 operator*(const Vector3& vector1) const;
+  Isometry& operator*=(const Isometry& isometry1);
+
+  friend std::ostream& operator<<(std::ostream &ss, const Isometry& isometry1);
+
+ private:
+  Vector3 translation_;
+  Matrix3 rotation_;
 };
 
+// Accumulates compositions into an Isometry and applies a fast
+// renormalization every period of them, so that long chains such as
+// odometry integration stay on SO(3). The policy lives here rather than in
+// Isometry, which stays a plain value.
+class RenormalizingIsometry {
+ public:
+  // A zero period disables the periodic renormalization.
+  explicit RenormalizingIsometry(
+      const std::size_t period,
+      const Isometry& isometry = Isometry::kIdentity);
+
+  const Isometry& isometry() const;
+  std::size_t period() const;
+  // Compositions since the last renormalization.
+  std::size_t compositions() const;
+
+  // Renormalizes now and restarts the count.
+  RenormalizingIsometry& renormalize(
+      const Renormalization mode = Renormalization::kFast);
+
+  // Composes isometry1 on the right of the accumulated value.
+  RenormalizingIsometry operator*(const Isometry& isometry1) const;
+  RenormalizingIsometry& operator*=(const Isometry& isometry1);
+
+ private:
+  Isometry isometry_;
+  std::size_t period_;
+  std::size_t compositions_{0};
+};
+
+constexpr Isometry::Isometry(const Vector3& translation,
+                             const Matrix3& rotation) :
+  translation_{translation}, rotation_{rotation} {}
+
+constexpr Isometry::Isometry() :
+  translation_{}, rotation_{} {}
+
+constexpr Isometry Isometry::fromTranslation(const Vector3& translation) {
+  return Isometry(translation, Matrix3(1.0, 0.0, 0.0,
+                                       0.0, 1.0, 0.0,
+                                       0.0, 0.0, 1.0));
+}
+
+constexpr const Vector3& Isometry::translation() const {
+  return translation_;
+}
+
+constexpr const Matrix3& Isometry::rotation() const {
+  return rotation_;
+}
+
+constexpr Vector3 Isometry::transform(const Vector3& vector1) const {
+  return rotation_ * vector1 + translation_;
+}
+
+constexpr Vector3 Isometry::inverseTransform(const Vector3& vector1) const {
+  return rotation_.transpose() * (vector1 - translation_);
+}
+
 }  // namespace math
 
 }  // namespace ekumen
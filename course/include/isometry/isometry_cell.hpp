@@ -0,0 +1,56 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Latest value cell to publish an Isometry from one writer thread to any
+// number of reader threads, without locks. It is a seqlock: the writer
+// bumps a sequence number to odd, writes, and bumps it back to even;
+// readers copy the value and retry if the sequence changed meanwhile.
+// Readers never block the writer nor each other.
+class alignas(64) IsometryCell {
+ public:
+  explicit IsometryCell(const Isometry& isometry = Isometry::kIdentity);
+  IsometryCell(const IsometryCell&) = delete;
+  IsometryCell& operator=(const IsometryCell&) = delete;
+
+  // Only one thread may store at a time.
+  void store(const Isometry& isometry);
+  // Retries while a store overlaps the read, which with stores taking tens
+  // of nanoseconds is rare even at kHz rates.
+  Isometry load() const;
+  // Wait-free single attempt: returns false and leaves result untouched
+  // when a store overlapped the read.
+  bool tryLoad(Isometry* result) const;
+  // Number of stores so far, lets readers tell whether the value changed.
+  std::uint64_t version() const;
+
+ private:
+  static constexpr std::size_t kWords = 12;
+
+  bool read(Isometry* result) const;
+
+  std::atomic<std::uint64_t> sequence_{0};
+  // Atomics rather than plain doubles, so that the torn reads the sequence
+  // check discards are not data races.
+  std::atomic<double> words_[kWords];
+};
+
+}  // namespace math
+
+}  // namespace ekumen
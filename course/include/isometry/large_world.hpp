@@ -0,0 +1,96 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+
+#include <isometry/isometry.hpp>
+#include <isometry/matrixn.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+typedef MatrixN<3, 1, float> Vector3f;
+typedef MatrixN<3, 3, float> Matrix3f;
+
+// Isometry for maps spanning tens of kilometers: the translation is kept in
+// double and the rotation in float, 60 bytes of data instead of 96.
+//
+// Precision: rounding the rotation to float perturbs each entry by at most
+// 2^-24 (6e-8) relative, so a point at range r from the pose moves by less
+// than about 1e-7 * r, i.e. 10 micrometers at 100 m. Arithmetic runs in
+// double and the translation is exact to about 1e-16 relative, 2 picometers
+// at 20 km. Composing n poses accumulates the rotation error linearly, about
+// 1e-7 * n radians; renormalize long chains through Isometry if needed.
+class LargeWorldIsometry {
+ public:
+  LargeWorldIsometry(const Vector3& translation, const Matrix3f& rotation);
+  // Identity transform.
+  LargeWorldIsometry();
+  // Rounds the rotation of isometry to float.
+  explicit LargeWorldIsometry(const Isometry& isometry);
+
+  Isometry toIsometry() const;
+
+  const Vector3& translation() const;
+  const Matrix3f& rotation() const;
+
+  Vector3 transform(const Vector3& vector1) const;
+  Vector3 transform(const Vector3f& vector1) const;
+  LargeWorldIsometry inverse() const;
+  LargeWorldIsometry compose(const LargeWorldIsometry& isometry1) const;
+
+  bool operator==(const LargeWorldIsometry& isometry1) const;
+  bool operator!=(const LargeWorldIsometry& isometry1) const;
+  LargeWorldIsometry operator*(const LargeWorldIsometry& isometry1) const;
+  Vector3 operator*(const Vector3& vector1) const;
+  Vector3 operator*(const Vector3f& vector1) const;
+
+  friend std::ostream& operator<<(std::ostream &ss,
+                                  const LargeWorldIsometry& isometry1);
+
+ private:
+  Vector3 translation_;
+  Matrix3f rotation_;
+};
+
+// Local frame anchored at a world position kept in double. Coordinates
+// relative to it fit in float: resolution is |local| * 2^-24, 0.06 mm at
+// 1 km from the origin, so rebase before the working area grows much larger
+// than the accuracy budget allows.
+class LocalOrigin {
+ public:
+  explicit LocalOrigin(const Vector3& origin);
+
+  const Vector3& origin() const;
+
+  Vector3f toLocal(const Vector3& world) const;
+  Vector3 toWorld(const Vector3f& local) const;
+
+  // Writes results[i] = toLocal(pose * points[i]), e.g. sensor points into
+  // the local map frame. The sum is formed in double and rounded to float
+  // once, so the only errors are the ones documented in LargeWorldIsometry
+  // plus the final rounding. points and results may be the same array.
+  void transform(const LargeWorldIsometry& pose, const Vector3f* points,
+                 Vector3f* results, const std::size_t count) const;
+
+  // Moves the origin to origin, shifting the count local points so that
+  // they keep their world position.
+  void rebase(const Vector3& origin, Vector3f* points,
+              const std::size_t count);
+
+ private:
+  Vector3 origin_;
+};
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,102 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Batches larger than this are transformed by first folding the product into
+// a single Isometry. Each extra factor costs a composition (36
+// multiplications) when folding, or one more mat-vec (9 multiplications) per
+// point when applied sequentially, so folding pays off beyond 4 points.
+constexpr std::size_t kFoldingBatchSize = 4;
+
+// Unevaluated product factor(0) * factor(1) * ... * factor(N - 1). Only
+// pointers to the factors are kept, so they must outlive the product; it is
+// meant to be consumed within the expression that builds it, as in
+// lazy(t1) * t2 * point.
+template <std::size_t N>
+class IsometryProduct {
+ public:
+  static_assert(N > 0, "A product needs at least one factor");
+
+  explicit IsometryProduct(const Isometry& head) {
+    static_assert(N == 1, "Only single factor products start from one");
+    factors_[0] = &head;
+  }
+  IsometryProduct(const IsometryProduct<N - 1>& head, const Isometry& tail) {
+    for (std::size_t i = 0; i + 1 < N; ++i) {
+      factors_[i] = &head.factor(i);
+    }
+    factors_[N - 1] = &tail;
+  }
+
+  const Isometry& factor(const std::size_t index) const {
+    return *factors_[index];
+  }
+
+  IsometryProduct<N + 1> operator*(const Isometry& isometry1) const {
+    return IsometryProduct<N + 1>(*this, isometry1);
+  }
+
+  // Composes the factors from left to right, like a chain of operator*.
+  Isometry evaluate() const {
+    Isometry result = *factors_[0];
+    for (std::size_t i = 1; i < N; ++i) {
+      result = result * *factors_[i];
+    }
+    return result;
+  }
+  operator Isometry() const { return evaluate(); }
+
+  // Applies the factors to vector1 from right to left, N mat-vecs and no
+  // 3x3 product.
+  Vector3 operator*(const Vector3& vector1) const {
+    Vector3 result = vector1;
+    for (std::size_t i = N; i > 0; --i) {
+      result = factors_[i - 1]->transform(result);
+    }
+    return result;
+  }
+
+  // Writes results[i] = *this * points[i]. Folds the product first when
+  // count exceeds kFoldingBatchSize, applies the factors point by point
+  // otherwise. points and results may be the same array.
+  void transform(const Vector3* points, Vector3* results,
+                 const std::size_t count) const {
+    if (N > 1 && count > kFoldingBatchSize) {
+      const Isometry folded = evaluate();
+      for (std::size_t i = 0; i < count; ++i) {
+        results[i] = folded.transform(points[i]);
+      }
+    } else {
+      for (std::size_t i = 0; i < count; ++i) {
+        results[i] = *this * points[i];
+      }
+    }
+  }
+
+ private:
+  const Isometry* factors_[N];
+};
+
+// Starts a lazy product: lazy(t1) * t2 * t3 defers every composition until
+// the product is applied to points or converted to an Isometry.
+inline IsometryProduct<1> lazy(const Isometry& isometry) {
+  return IsometryProduct<1>(isometry);
+}
+
+}  // namespace math
+
+}  // namespace ekumen
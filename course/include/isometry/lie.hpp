@@ -0,0 +1,70 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+
+#include <isometry/isometry.hpp>
+#include <isometry/matrixn.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Element of se(3): linear part and angular part, the latter a rotation
+// vector (axis times angle). As a 6-vector it is (linear, angular).
+struct Twist {
+  Vector3 linear;
+  Vector3 angular;
+
+  Vector6 vector() const;
+  static Twist fromVector(const Vector6& vector1);
+
+  bool operator==(const Twist& twist1) const;
+  bool operator!=(const Twist& twist1) const;
+  Twist operator+(const Twist& twist1) const;
+  Twist operator-(const Twist& twist1) const;
+  Twist operator*(const double scalar) const;
+};
+
+std::ostream& operator<<(std::ostream &ss, const Twist& twist1);
+
+// Angles below this use Taylor expansions of the Rodrigues coefficients,
+// which are exact to double precision there while the closed forms lose
+// digits to cancellation.
+constexpr double kSmallAngle = 1e-2;
+
+// Exponential map of so(3): the rotation of |omega| radians around omega.
+Matrix3 expSO3(const Vector3& omega);
+// Logarithm of a rotation matrix, with angle in [0, pi]. Accurate near the
+// identity and near half turns.
+Vector3 logSO3(const Matrix3& rotation);
+
+// Exponential map of se(3). The translation is V * linear, V being the left
+// Jacobian of SO(3) at angular.
+Isometry expSE3(const Twist& twist);
+// Inverse of expSE3(), expects a rotation matrix.
+Twist logSE3(const Isometry& isometry);
+
+// Adjoint action of isometry on twist: the twist expressed in the frame
+// isometry maps into, Ad(T) * (v, w) = (R * v + t x (R * w), R * w).
+Twist adjoint(const Isometry& isometry, const Twist& twist);
+
+// Batched versions, results[i] = f(inputs[i]).
+void expSO3(const Vector3* omegas, Matrix3* results, const std::size_t count);
+void logSO3(const Matrix3* rotations, Vector3* results,
+            const std::size_t count);
+void expSE3(const Twist* twists, Isometry* results, const std::size_t count);
+void logSE3(const Isometry* isometries, Twist* results,
+            const std::size_t count);
+
+}  // namespace math
+
+}  // namespace ekumen
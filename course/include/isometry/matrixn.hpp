@@ -0,0 +1,220 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ekumen {
+
+namespace math {
+
+namespace internal {
+
+// Calls function(i) for every i in [Begin, End). The iteration is expanded
+// at compile time, so there is no loop left for the optimizer to unroll.
+template <std::size_t Begin, std::size_t End>
+struct Unroll {
+  template <typename Function>
+  static void apply(const Function& function) {
+    function(Begin);
+    Unroll<Begin + 1, End>::apply(function);
+  }
+};
+
+template <std::size_t End>
+struct Unroll<End, End> {
+  template <typename Function>
+  static void apply(const Function&) {}
+};
+
+}  // namespace internal
+
+// Fixed size R x C matrix of T, stored row-major. Arithmetic operators work
+// element-wise like in Vector3 and Matrix3; product() is the matrix product.
+template <std::size_t R, std::size_t C, typename T = double>
+class MatrixN {
+ public:
+  static_assert(R > 0 && C > 0, "MatrixN needs at least one element");
+
+  static constexpr std::size_t kRows = R;
+  static constexpr std::size_t kCols = C;
+
+  constexpr MatrixN() : values_{} {}
+  // Takes exactly R * C values, row after row.
+  template <typename... Values, typename = typename std::enable_if<
+                                    sizeof...(Values) == R * C>::type>
+  constexpr explicit MatrixN(const Values... values) :
+    values_{static_cast<T>(values)...} {}
+
+  static MatrixN zero() { return MatrixN(); }
+  static MatrixN identity() {
+    static_assert(R == C, "Only square matrices have an identity");
+    MatrixN result;
+    internal::Unroll<0, R>::apply([&](std::size_t i) {
+      result(i, i) = T{1};
+    });
+    return result;
+  }
+
+  // Unchecked access.
+  constexpr T operator()(std::size_t row, std::size_t col) const & {
+    return values_[row * C + col];
+  }
+  T& operator()(std::size_t row, std::size_t col) & {
+    return values_[row * C + col];
+  }
+  // Checked access, throws std::out_of_range.
+  constexpr T at(std::size_t row, std::size_t col) const & {
+    return (row >= R || col >= C) ?
+           throw std::out_of_range("Index out of range") :
+           values_[row * C + col];
+  }
+  T& at(std::size_t row, std::size_t col) & {
+    if (row >= R || col >= C) {
+      throw std::out_of_range("Index out of range");
+    }
+    return values_[row * C + col];
+  }
+
+  const T* data() const { return values_; }
+  T* data() { return values_; }
+
+  MatrixN<C, R, T> transpose() const {
+    MatrixN<C, R, T> result;
+    internal::Unroll<0, R * C>::apply([&](std::size_t i) {
+      result(i % C, i / C) = values_[i];
+    });
+    return result;
+  }
+
+  template <std::size_t K>
+  MatrixN<R, K, T> product(const MatrixN<C, K, T>& matrix1) const {
+    MatrixN<R, K, T> result;
+    internal::Unroll<0, R * K>::apply([&](std::size_t i) {
+      const std::size_t row = i / K;
+      const std::size_t col = i % K;
+      T sum{};
+      internal::Unroll<0, C>::apply([&](std::size_t k) {
+        sum += values_[row * C + k] * matrix1(k, col);
+      });
+      result(row, col) = sum;
+    });
+    return result;
+  }
+
+  // Element-wise comparison with the same absolute tolerance as Vector3.
+  bool operator==(const MatrixN& matrix1) const {
+    bool equal = true;
+    internal::Unroll<0, R * C>::apply([&](std::size_t i) {
+      equal = equal && std::fabs(values_[i] - matrix1.values_[i]) < 1e-5;
+    });
+    return equal;
+  }
+  bool operator!=(const MatrixN& matrix1) const {
+    return !(*this == matrix1);
+  }
+
+  MatrixN operator+(const MatrixN& matrix1) const {
+    return MatrixN(*this) += matrix1;
+  }
+  MatrixN operator-(const MatrixN& matrix1) const {
+    return MatrixN(*this) -= matrix1;
+  }
+  MatrixN operator*(const MatrixN& matrix1) const {
+    return MatrixN(*this) *= matrix1;
+  }
+  MatrixN operator/(const MatrixN& matrix1) const {
+    return MatrixN(*this) /= matrix1;
+  }
+  MatrixN operator*(const T scalar) const {
+    return MatrixN(*this) *= scalar;
+  }
+  MatrixN operator/(const T scalar) const {
+    return MatrixN(*this) /= scalar;
+  }
+
+  MatrixN& operator+=(const MatrixN& matrix1) {
+    internal::Unroll<0, R * C>::apply([&](std::size_t i) {
+      values_[i] += matrix1.values_[i];
+    });
+    return *this;
+  }
+  MatrixN& operator-=(const MatrixN& matrix1) {
+    internal::Unroll<0, R * C>::apply([&](std::size_t i) {
+      values_[i] -= matrix1.values_[i];
+    });
+    return *this;
+  }
+  MatrixN& operator*=(const MatrixN& matrix1) {
+    internal::Unroll<0, R * C>::apply([&](std::size_t i) {
+      values_[i] *= matrix1.values_[i];
+    });
+    return *this;
+  }
+  MatrixN& operator/=(const MatrixN& matrix1) {
+    internal::Unroll<0, R * C>::apply([&](std::size_t i) {
+      values_[i] /= matrix1.values_[i];
+    });
+    return *this;
+  }
+  MatrixN& operator*=(const T scalar) {
+    internal::Unroll<0, R * C>::apply([&](std::size_t i) {
+      values_[i] *= scalar;
+    });
+    return *this;
+  }
+  MatrixN& operator/=(const T scalar) {
+    internal::Unroll<0, R * C>::apply([&](std::size_t i) {
+      values_[i] /= scalar;
+    });
+    return *this;
+  }
+
+  friend MatrixN operator*(const T scalar, const MatrixN& matrix1) {
+    return matrix1 * scalar;
+  }
+
+ private:
+  T values_[R * C];
+};
+
+template <std::size_t R, std::size_t C, typename T>
+constexpr std::size_t MatrixN<R, C, T>::kRows;
+template <std::size_t R, std::size_t C, typename T>
+constexpr std::size_t MatrixN<R, C, T>::kCols;
+
+// Prints [[a, b], [c, d]], the same layout as Matrix3.
+template <std::size_t R, std::size_t C, typename T>
+std::ostream& operator<<(std::ostream &ss, const MatrixN<R, C, T>& matrix1) {
+  ss << "[";
+  for (std::size_t row = 0; row < R; ++row) {
+    ss << (row == 0 ? "[" : ", [");
+    for (std::size_t col = 0; col < C; ++col) {
+      ss << (col == 0 ? "" : ", ") << matrix1(row, col);
+    }
+    ss << "]";
+  }
+  ss << "]";
+  return ss;
+}
+
+typedef MatrixN<2, 1> Vector2;
+typedef MatrixN<4, 1> Vector4;
+typedef MatrixN<6, 1> Vector6;
+typedef MatrixN<2, 2> Matrix2;
+typedef MatrixN<4, 4> Matrix4;
+typedef MatrixN<6, 6> Matrix6;
+
+}  // namespace math
+
+}  // namespace ekumen
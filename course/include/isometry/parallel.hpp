@@ -0,0 +1,53 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ekumen {
+
+namespace math {
+
+namespace internal {
+
+// Number of blocks to split count elements into: at most threads, and none
+// smaller than min_block elements.
+inline std::size_t parallelBlocks(const std::size_t count,
+                                  const std::size_t threads,
+                                  const std::size_t min_block) {
+  return std::max<std::size_t>(1, std::min(threads, count / min_block));
+}
+
+// Calls function(block, begin, size) for every block, one thread each. The
+// last block runs on the calling thread.
+template <typename Function>
+void forEachBlock(const std::size_t count, const std::size_t blocks,
+                  const Function& function) {
+  std::vector<std::thread> workers;
+  workers.reserve(blocks - 1);
+  for (std::size_t block = 0; block + 1 < blocks; ++block) {
+    const std::size_t begin = count * block / blocks;
+    const std::size_t end = count * (block + 1) / blocks;
+    workers.emplace_back(function, block, begin, end - begin);
+  }
+  const std::size_t begin = count * (blocks - 1) / blocks;
+  function(blocks - 1, begin, count - begin);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+}  // namespace internal
+
+}  // namespace math
+
+}  // namespace ekumen
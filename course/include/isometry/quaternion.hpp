@@ -0,0 +1,147 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <iostream>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Quaternion w + xi + yj + zk. Unit quaternions represent rotations, with q
+// and -q being the same rotation.
+class Quaternion {
+ public:
+  constexpr Quaternion(const double w, const double x, const double y,
+                       const double z);
+  // Identity rotation.
+  constexpr Quaternion();
+
+  static Quaternion fromAxisAngle(const Vector3& axis, const double angle);
+  // Expects a rotation matrix; other matrices give meaningless results.
+  static Quaternion fromRotationMatrix(const Matrix3& rotation);
+  Matrix3 toRotationMatrix() const;
+
+  constexpr double w() const;
+  constexpr double x() const;
+  constexpr double y() const;
+  constexpr double z() const;
+  // Imaginary part.
+  constexpr Vector3 vec() const;
+
+  double norm() const;
+  Quaternion normalized() const;
+  constexpr Quaternion conjugate() const;
+  constexpr double dot(const Quaternion& quaternion1) const;
+
+  // Hamilton product, 16 multiplications.
+  Quaternion product(const Quaternion& quaternion1) const;
+  // Rotates vector1 by this unit quaternion, 18 multiplications.
+  Vector3 rotate(const Vector3& vector1) const;
+
+  static const Quaternion kIdentity;
+
+  bool operator==(const Quaternion& quaternion1) const;
+  bool operator!=(const Quaternion& quaternion1) const;
+  Quaternion operator+(const Quaternion& quaternion1) const;
+  Quaternion operator-(const Quaternion& quaternion1) const;
+  Quaternion operator*(const Quaternion& quaternion1) const;
+  Quaternion operator*(const double scalar) const;
+  Vector3 operator*(const Vector3& vector1) const;
+
+  friend Quaternion operator*(const double scalar,
+                              const Quaternion& quaternion1);
+  friend std::ostream& operator<<(std::ostream &ss,
+                                  const Quaternion& quaternion1);
+
+ private:
+  double w_;
+  double x_;
+  double y_;
+  double z_;
+};
+
+constexpr Quaternion::Quaternion(const double w, const double x,
+                                 const double y, const double z) :
+  w_{w}, x_{x}, y_{y}, z_{z} {}
+
+constexpr Quaternion::Quaternion() :
+  w_{1.0}, x_{0.0}, y_{0.0}, z_{0.0} {}
+
+constexpr double Quaternion::w() const {
+  return w_;
+}
+
+constexpr double Quaternion::x() const {
+  return x_;
+}
+
+constexpr double Quaternion::y() const {
+  return y_;
+}
+
+constexpr double Quaternion::z() const {
+  return z_;
+}
+
+constexpr Vector3 Quaternion::vec() const {
+  return Vector3(x_, y_, z_);
+}
+
+constexpr Quaternion Quaternion::conjugate() const {
+  return Quaternion(w_, -x_, -y_, -z_);
+}
+
+constexpr double Quaternion::dot(const Quaternion& quaternion1) const {
+  return w_ * quaternion1.w_ + x_ * quaternion1.x_ + y_ * quaternion1.y_ +
+         z_ * quaternion1.z_;
+}
+
+// Isometry stored as a unit quaternion and a translation, 7 doubles instead
+// of 12. Composition costs 16 multiplications for the rotation part instead
+// of 27; the rotation matrix is only built when asked for.
+class QuaternionIsometry {
+ public:
+  QuaternionIsometry(const Vector3& translation, const Quaternion& rotation);
+  // Identity transform.
+  QuaternionIsometry();
+  // Expects isometry.rotation() to be a rotation matrix.
+  explicit QuaternionIsometry(const Isometry& isometry);
+
+  Isometry toIsometry() const;
+
+  const Vector3& translation() const;
+  const Quaternion& rotation() const;
+  Matrix3 rotationMatrix() const;
+
+  Vector3 transform(const Vector3& vector1) const;
+  QuaternionIsometry inverse() const;
+  QuaternionIsometry compose(const QuaternionIsometry& isometry1) const;
+  // Rescales the quaternion to unit norm, removing accumulated drift.
+  QuaternionIsometry& normalize();
+
+  bool operator==(const QuaternionIsometry& isometry1) const;
+  bool operator!=(const QuaternionIsometry& isometry1) const;
+  QuaternionIsometry operator*(const QuaternionIsometry& isometry1) const;
+  Vector3 operator*(const Vector3& vector1) const;
+  QuaternionIsometry& operator*=(const QuaternionIsometry& isometry1);
+
+  friend std::ostream& operator<<(std::ostream &ss,
+                                  const QuaternionIsometry& isometry1);
+
+ private:
+  Vector3 translation_;
+  Quaternion rotation_;
+};
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,49 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Decomposition matrix = u * diag(s) * v^T. Both u and v are proper rotations
+// and s is sorted by decreasing magnitude; s.z() carries the sign of det().
+struct SVD3 {
+  Matrix3 u;
+  Vector3 s;
+  Matrix3 v;
+};
+
+// Fixed-iteration 3x3 SVD after McAdams et al. (2011): cyclic Jacobi on
+// matrix^T * matrix, sign-preserving column sort and a Givens QR. No loop
+// depends on the input, so the cost is the same for every matrix.
+SVD3 svd(const Matrix3& matrix);
+
+// Decomposes count matrices, writing results[i] = svd(matrices[i]).
+void svd(const Matrix3* matrices, SVD3* results, std::size_t count);
+
+// Reference one-sided Jacobi SVD, iterated until convergence. Same output
+// conventions as svd(); kept for validation and benchmarking.
+SVD3 jacobiSvd(const Matrix3& matrix);
+
+// Rotation closest to matrix in the Frobenius norm (projection onto SO(3)).
+Matrix3 nearestRotation(const Matrix3& matrix);
+
+// Kabsch fit: rotation r minimizing sum |r * (source[i] - cs) - (target[i] -
+// ct)|^2, where cs and ct are the centroids of each point set.
+Matrix3 fitRotation(const Vector3* source, const Vector3* target,
+                    std::size_t count);
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,96 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Non owning view of count points stored as x, y, z doubles, with stride
+// bytes from one point to the next: 3 * sizeof(double) for packed xyz
+// arrays, sizeof(Point) for the position field of a larger Point struct.
+// T is double, or const double for inputs.
+template <typename T>
+struct StridedPoints {
+  T* xyz;
+  std::size_t count;
+  std::size_t stride;
+};
+
+// Non owning view of count points stored as three coordinate arrays.
+// T is double, or const double for inputs.
+template <typename T>
+struct SoAPoints {
+  T* x;
+  T* y;
+  T* z;
+  std::size_t count;
+};
+
+// Batches shorter than this per thread are transformed on the calling
+// thread.
+constexpr std::size_t kMinParallelPoints = 1 << 16;
+
+// Batched isometry * point. Each call writes results[i] = isometry *
+// points[i] for every point, splitting the batch across up to threads
+// threads when it is long enough. Inputs and outputs may be the same
+// memory; the InPlace forms are shorthands for that. Views with different
+// counts throw std::invalid_argument.
+void transform(const Isometry& isometry, const Vector3* points,
+               Vector3* results, const std::size_t count,
+               const std::size_t threads = 1);
+void transform(const Isometry& isometry,
+               const StridedPoints<const double>& points,
+               const StridedPoints<double>& results,
+               const std::size_t threads = 1);
+void transform(const Isometry& isometry, const SoAPoints<const double>& points,
+               const SoAPoints<double>& results,
+               const std::size_t threads = 1);
+
+void transformInPlace(const Isometry& isometry, Vector3* points,
+                      const std::size_t count, const std::size_t threads = 1);
+void transformInPlace(const Isometry& isometry,
+                      const StridedPoints<double>& points,
+                      const std::size_t threads = 1);
+void transformInPlace(const Isometry& isometry,
+                      const SoAPoints<double>& points,
+                      const std::size_t threads = 1);
+
+// Batched isometry.inverse() * point, with the same conventions as
+// transform(). The inverse rotation and translation are derived once from
+// the stored pose; no inverse Isometry is built.
+void inverseTransform(const Isometry& isometry, const Vector3* points,
+                      Vector3* results, const std::size_t count,
+                      const std::size_t threads = 1);
+void inverseTransform(const Isometry& isometry,
+                      const StridedPoints<const double>& points,
+                      const StridedPoints<double>& results,
+                      const std::size_t threads = 1);
+void inverseTransform(const Isometry& isometry,
+                      const SoAPoints<const double>& points,
+                      const SoAPoints<double>& results,
+                      const std::size_t threads = 1);
+
+void inverseTransformInPlace(const Isometry& isometry, Vector3* points,
+                             const std::size_t count,
+                             const std::size_t threads = 1);
+void inverseTransformInPlace(const Isometry& isometry,
+                             const StridedPoints<double>& points,
+                             const std::size_t threads = 1);
+void inverseTransformInPlace(const Isometry& isometry,
+                             const SoAPoints<double>& points,
+                             const std::size_t threads = 1);
+
+}  // namespace math
+
+}  // namespace ekumen
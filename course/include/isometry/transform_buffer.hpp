@@ -0,0 +1,115 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <isometry/interpolation.hpp>
+#include <isometry/isometry.hpp>
+#include <isometry/lie.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+struct StampedIsometry {
+  // Seconds, in whatever clock the producer uses.
+  double stamp;
+  Isometry isometry;
+};
+
+// Time ordered history of poses kept in a fixed size ring. All the storage
+// is allocated on construction; inserting never allocates. A sample leaves
+// the buffer when the ring is full or when it is more than retention
+// seconds older than the newest one.
+class TransformBuffer {
+ public:
+  // Throws std::invalid_argument when capacity is zero or retention is not
+  // positive.
+  explicit TransformBuffer(
+      const std::size_t capacity,
+      const double retention = std::numeric_limits<double>::infinity());
+
+  // Appends a sample. Throws std::invalid_argument unless stamp is newer
+  // than the newest sample.
+  void insert(const double stamp, const Isometry& isometry);
+  void insert(const StampedIsometry& sample);
+  void clear();
+
+  // Drops the samples that are too old for the new retention right away.
+  void setRetention(const double retention);
+  double retention() const;
+
+  std::size_t capacity() const;
+  std::size_t size() const;
+  bool empty() const;
+
+  // i-th sample from the oldest one, no bounds checking.
+  const StampedIsometry& operator[](const std::size_t i) const;
+  // Throw std::out_of_range when the buffer is empty.
+  const StampedIsometry& oldest() const;
+  const StampedIsometry& newest() const;
+
+  // Index of the newest sample with a stamp not after stamp, found with a
+  // binary search. Throws std::out_of_range when stamp is before the oldest
+  // sample.
+  std::size_t find(const double stamp) const;
+  // Pose at stamp, interpolated between the samples around it. Throws
+  // std::out_of_range when stamp falls outside [oldest, newest].
+  Isometry lookup(const double stamp,
+                  const Interpolation mode = Interpolation::kSlerp) const;
+  // Batched lookup of ascending stamps, e.g. the points of a scan. Walks the
+  // stamps and the samples together, one binary search in total, and
+  // reuses the interpolator while consecutive stamps fall between the
+  // same pair of samples. Throws std::invalid_argument when stamps are not
+  // sorted and std::out_of_range as lookup().
+  void lookup(const double* stamps, Isometry* results,
+              const std::size_t count,
+              const Interpolation mode = Interpolation::kSlerp) const;
+  // Same walk, writing results[i] = lookup(stamps[i]) * points[i] without
+  // storing the poses. Deskews a scan given per point stamps.
+  void transform(const double* stamps, const Vector3* points,
+                 Vector3* results, const std::size_t count,
+                 const Interpolation mode = Interpolation::kSlerp) const;
+
+  // Body twist per second of the newest sample, estimated from the motion
+  // since the newest sample at least baseline seconds older, or the oldest
+  // one. Longer baselines average out noise but lag behind changes. Throws
+  // std::out_of_range with fewer than two samples.
+  Twist velocity(const double baseline = 0.0) const;
+  // Pose at stamp, not before the newest sample, assuming velocity() stays
+  // constant. Costs a binary search, a logarithm and an exponential; to
+  // predict many stamps, call velocity() once and the free extrapolate().
+  // Throws std::out_of_range when stamp is before the newest sample.
+  Isometry extrapolate(const double stamp, const double baseline = 0.0) const;
+
+ private:
+  void dropOlderThan(const double stamp);
+  // Calls function(i, pose) with the pose at stamps[i], in order.
+  template <typename Function>
+  void walk(const double* stamps, const std::size_t count,
+            const Interpolation mode, Function function) const;
+
+  std::vector<StampedIsometry> samples_;
+  // Position of the oldest sample in samples_.
+  std::size_t head_{0};
+  std::size_t size_{0};
+  double retention_;
+};
+
+// sample.isometry * exp(velocity * (stamp - sample.stamp)): constant body
+// twist motion from sample, one exponential per call.
+Isometry extrapolate(const StampedIsometry& sample, const Twist& velocity,
+                     const double stamp);
+
+}  // namespace math
+
+}  // namespace ekumen
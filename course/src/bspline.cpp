@@ -0,0 +1,129 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/bspline.hpp>
+
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+  CubicBSplineTrajectory::CubicBSplineTrajectory(
+      const Isometry* control_poses, const std::size_t count,
+      const double start, const double interval) :
+    start_{start}, interval_{interval} {
+    if (count < 4) {
+      throw std::invalid_argument("A cubic B-spline needs 4 control poses");
+    }
+    if (!(interval > 0.0)) {
+      throw std::invalid_argument("Knot interval must be positive");
+    }
+    control_poses_.assign(control_poses, control_poses + count);
+    deltas_.resize(count);
+    for (std::size_t k = 1; k < count; ++k) {
+      deltas_[k] = logSE3(control_poses[k - 1].inverse() * control_poses[k]);
+    }
+  }
+
+  double CubicBSplineTrajectory::startTime() const {
+    return start_;
+  }
+
+  double CubicBSplineTrajectory::endTime() const {
+    return start_ + segments() * interval_;
+  }
+
+  std::size_t CubicBSplineTrajectory::segments() const {
+    return control_poses_.size() - 3;
+  }
+
+  Isometry CubicBSplineTrajectory::evaluate(const double time) const {
+    return evaluate(time, nullptr);
+  }
+
+  Isometry CubicBSplineTrajectory::evaluate(const double time,
+                                            Twist* velocity) const {
+    double u;
+    const std::size_t s = segment(time, &u);
+    return evaluate(s, u, velocity);
+  }
+
+  void CubicBSplineTrajectory::evaluate(const double* times,
+                                        Isometry* results,
+                                        const std::size_t count,
+                                        Twist* velocities) const {
+    if (count == 0) {
+      return;
+    }
+    double u;
+    std::size_t s = segment(times[0], &u);
+    double segment_start = start_ + s * interval_;
+    const double end = endTime();
+    const std::size_t last = segments() - 1;
+    for (std::size_t i = 0; i < count; ++i) {
+      const double time = times[i];
+      if (i > 0 && time < times[i - 1]) {
+        throw std::invalid_argument("Times must be sorted");
+      }
+      if (time > end) {
+        throw std::out_of_range("Time is after the end of the trajectory");
+      }
+      while (s < last && time >= segment_start + interval_) {
+        ++s;
+        segment_start += interval_;
+      }
+      results[i] = evaluate(s, (time - segment_start) / interval_,
+                            velocities == nullptr ? nullptr : velocities + i);
+    }
+  }
+
+  std::size_t CubicBSplineTrajectory::segment(const double time,
+                                              double* u) const {
+    if (!(time >= start_ && time <= endTime())) {
+      throw std::out_of_range("Time is outside the trajectory");
+    }
+    const double position = (time - start_) / interval_;
+    std::size_t s = static_cast<std::size_t>(position);
+    if (s >= segments()) {
+      s = segments() - 1;
+    }
+    *u = position - s;
+    return s;
+  }
+
+  Isometry CubicBSplineTrajectory::evaluate(const std::size_t segment,
+                                            const double u,
+                                            Twist* velocity) const {
+    const double u2 = u * u;
+    const double u3 = u2 * u;
+    const double b[3] = {(5.0 + 3.0 * u - 3.0 * u2 + u3) / 6.0,
+                         (1.0 + 3.0 * u + 3.0 * u2 - 2.0 * u3) / 6.0,
+                         u3 / 6.0};
+    Isometry pose = control_poses_[segment];
+    Twist body{};
+    for (std::size_t j = 0; j < 3; ++j) {
+      const Twist& delta = deltas_[segment + j + 1];
+      const Isometry step = expSE3(delta * b[j]);
+      pose = pose * step;
+      if (velocity != nullptr) {
+        // Body velocity of T * A_j is Ad(A_j^-1) of the previous one plus
+        // db_j/dt * d_j.
+        const double db[3] = {(1.0 - 2.0 * u + u2) / 2.0,
+                              (1.0 + 2.0 * u - 2.0 * u2) / 2.0,
+                              u2 / 2.0};
+        body = adjoint(step.inverse(), body) + delta * (db[j] / interval_);
+      }
+    }
+    if (velocity != nullptr) {
+      *velocity = body;
+    }
+    return pose;
+  }
+
+}  // namespace math
+}  // namespace ekumen
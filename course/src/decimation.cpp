@@ -0,0 +1,134 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/decimation.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <isometry/constexpr_math.hpp>
+#include <isometry/interpolation.hpp>
+#include <isometry/quaternion.hpp>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  using internal::kPi;
+
+  // How far past its limit a squared error is, > 1 meaning out of bounds.
+  double ratio(const double error, const double limit) {
+    if (limit > 0.0) {
+      return error / limit;
+    }
+    return error > 0.0 ? std::numeric_limits<double>::max() : 0.0;
+  }
+
+  // Squared translation distance between sample and the kSlerp pose of
+  // interpolator at its stamp, and the squared sine of half the rotation
+  // angle between them. Both grow with the distance, which is all the
+  // tolerance checks need, without square roots nor arc tangents.
+  void errors(const IsometryInterpolator& interpolator, const double t,
+              const StampedIsometry& sample, const Quaternion& rotation,
+              double* translation_error, double* rotation_error) {
+    Quaternion interpolated;
+    Vector3 translation;
+    interpolator.slerpParts(t, &interpolated, &translation);
+    const Vector3 d = sample.isometry.translation() - translation;
+    *translation_error = d.dot(d);
+    // sin^2(angle / 2) = |v|^2 / (|v|^2 + w^2) does not depend on the
+    // norm of the interpolated quaternion, so it is not normalized.
+    const Quaternion relative = interpolated.conjugate().product(rotation);
+    const Vector3 v = relative.vec();
+    const double square = v.dot(v);
+    *rotation_error = square / (square + relative.w() * relative.w());
+  }
+
+}  // namespace
+
+  std::vector<std::size_t> decimate(const StampedIsometry* samples,
+                                    const std::size_t count,
+                                    const double translation_tolerance,
+                                    const double rotation_tolerance) {
+    if (translation_tolerance < 0.0 || rotation_tolerance < 0.0) {
+      throw std::invalid_argument("Tolerances must not be negative");
+    }
+    const double translation_limit =
+        translation_tolerance * translation_tolerance;
+    const double half_tolerance = std::min(rotation_tolerance, kPi) / 2.0;
+    const double rotation_limit =
+        std::sin(half_tolerance) * std::sin(half_tolerance);
+    std::vector<Quaternion> rotations(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      if (i > 0 && !(samples[i].stamp > samples[i - 1].stamp)) {
+        throw std::invalid_argument("Stamps must be strictly increasing");
+      }
+      rotations[i] =
+          Quaternion::fromRotationMatrix(samples[i].isometry.rotation());
+    }
+    std::vector<bool> keep(count, false);
+    if (count > 0) {
+      keep.front() = true;
+      keep.back() = true;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    if (count > 2) {
+      ranges.emplace_back(0, count - 1);
+    }
+    while (!ranges.empty()) {
+      const std::size_t first = ranges.back().first;
+      const std::size_t last = ranges.back().second;
+      ranges.pop_back();
+      const IsometryInterpolator interpolator(samples[first].isometry,
+                                              samples[last].isometry,
+                                              Interpolation::kSlerp);
+      const double duration = samples[last].stamp - samples[first].stamp;
+      double worst = 1.0;
+      std::size_t split = first;
+      for (std::size_t k = first + 1; k < last; ++k) {
+        const double t = (samples[k].stamp - samples[first].stamp) / duration;
+        double translation_error;
+        double rotation_error;
+        errors(interpolator, t, samples[k], rotations[k], &translation_error,
+               &rotation_error);
+        const double error =
+            std::max(ratio(translation_error, translation_limit),
+                     ratio(rotation_error, rotation_limit));
+        if (error > worst) {
+          worst = error;
+          split = k;
+        }
+      }
+      if (split == first) {
+        continue;
+      }
+      keep[split] = true;
+      if (split - first > 1) {
+        ranges.emplace_back(first, split);
+      }
+      if (last - split > 1) {
+        ranges.emplace_back(split, last);
+      }
+    }
+
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < count; ++i) {
+      if (keep[i]) {
+        indices.push_back(i);
+      }
+    }
+    return indices;
+  }
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,147 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/dual_quaternion.hpp>
+
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  Quaternion pure(const Vector3& vector1) {
+    return {0.0, vector1.x(), vector1.y(), vector1.z()};
+  }
+
+}  // namespace
+
+  DualQuaternion::DualQuaternion(const Quaternion& real,
+                                 const Quaternion& dual) :
+    real_{real}, dual_{dual} {}
+
+  DualQuaternion::DualQuaternion() :
+    real_{Quaternion::kIdentity}, dual_{0.0, 0.0, 0.0, 0.0} {}
+
+  DualQuaternion::DualQuaternion(const Isometry& isometry) :
+    DualQuaternion(QuaternionIsometry(isometry)) {}
+
+  DualQuaternion::DualQuaternion(const QuaternionIsometry& isometry) :
+    real_{isometry.rotation()},
+    dual_{pure(isometry.translation()).product(isometry.rotation()) * 0.5} {}
+
+  Isometry DualQuaternion::toIsometry() const {
+    return toQuaternionIsometry().toIsometry();
+  }
+
+  QuaternionIsometry DualQuaternion::toQuaternionIsometry() const {
+    return {translation(), real_};
+  }
+
+  const Quaternion& DualQuaternion::real() const {
+    return real_;
+  }
+
+  const Quaternion& DualQuaternion::dual() const {
+    return dual_;
+  }
+
+  Vector3 DualQuaternion::translation() const {
+    const Quaternion t = dual_.product(real_.conjugate());
+    return Vector3(2.0 * t.x(), 2.0 * t.y(), 2.0 * t.z());
+  }
+
+  DualQuaternion DualQuaternion::conjugate() const {
+    return {real_.conjugate(), dual_.conjugate()};
+  }
+
+  DualQuaternion DualQuaternion::normalized() const {
+    const double inverse_norm = 1.0 / real_.norm();
+    const Quaternion real = real_ * inverse_norm;
+    const Quaternion dual = dual_ * inverse_norm;
+    return {real, dual - real * real.dot(dual)};
+  }
+
+  DualQuaternion DualQuaternion::compose(
+      const DualQuaternion& dual_quaternion1) const {
+    return {real_.product(dual_quaternion1.real_),
+            real_.product(dual_quaternion1.dual_) +
+                dual_.product(dual_quaternion1.real_)};
+  }
+
+  Vector3 DualQuaternion::transform(const Vector3& vector1) const {
+    return real_.rotate(vector1) + translation();
+  }
+
+  DualQuaternion DualQuaternion::blend(
+      const DualQuaternion* dual_quaternions, const double* weights,
+      const std::size_t count) {
+    if (count == 0) {
+      throw std::invalid_argument("Cannot blend no dual quaternions");
+    }
+    const Quaternion& pivot = dual_quaternions[0].real_;
+    DualQuaternion sum(Quaternion(0.0, 0.0, 0.0, 0.0),
+                       Quaternion(0.0, 0.0, 0.0, 0.0));
+    for (std::size_t i = 0; i < count; ++i) {
+      const DualQuaternion& q = dual_quaternions[i];
+      const double weight =
+          pivot.dot(q.real_) < 0.0 ? -weights[i] : weights[i];
+      sum.real_ = sum.real_ + q.real_ * weight;
+      sum.dual_ = sum.dual_ + q.dual_ * weight;
+    }
+    if (sum.real_.dot(sum.real_) == 0.0) {
+      throw std::invalid_argument("Blend weights cancel out");
+    }
+    return sum.normalized();
+  }
+
+  bool DualQuaternion::operator==(
+      const DualQuaternion& dual_quaternion1) const {
+    return (real_ == dual_quaternion1.real_ &&
+            dual_ == dual_quaternion1.dual_) ||
+           (real_ == dual_quaternion1.real_ * -1.0 &&
+            dual_ == dual_quaternion1.dual_ * -1.0);
+  }
+
+  bool DualQuaternion::operator!=(
+      const DualQuaternion& dual_quaternion1) const {
+    return !(*this == dual_quaternion1);
+  }
+
+  DualQuaternion DualQuaternion::operator+(
+      const DualQuaternion& dual_quaternion1) const {
+    return {real_ + dual_quaternion1.real_, dual_ + dual_quaternion1.dual_};
+  }
+
+  DualQuaternion DualQuaternion::operator*(
+      const DualQuaternion& dual_quaternion1) const {
+    return compose(dual_quaternion1);
+  }
+
+  DualQuaternion DualQuaternion::operator*(const double scalar) const {
+    return {real_ * scalar, dual_ * scalar};
+  }
+
+  Vector3 DualQuaternion::operator*(const Vector3& vector1) const {
+    return transform(vector1);
+  }
+
+  DualQuaternion operator*(const double scalar,
+                           const DualQuaternion& dual_quaternion1) {
+    return dual_quaternion1 * scalar;
+  }
+
+  std::ostream& operator<<(std::ostream &ss,
+                           const DualQuaternion& dual_quaternion1) {
+    ss << "[R: " << dual_quaternion1.real_
+       << ", D: " << dual_quaternion1.dual_ << "]";
+    return ss;
+  }
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,278 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/frame_tree.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  // 2^64 / golden ratio, spreads consecutive keys over the slots.
+  const std::uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ull;
+
+  // Serial of the next tree. Zero is left for default constructed handles.
+  std::atomic<std::uint64_t> next_serial{1};
+
+  std::uint64_t nextSerial() {
+    return next_serial.fetch_add(1, std::memory_order_relaxed);
+  }
+
+}  // namespace
+
+  constexpr std::size_t FrameTree::kNoParent;
+
+  FrameTree::FrameTree(const std::string& root, const std::size_t capacity) :
+    serial_{nextSerial()} {
+    frames_.reserve(capacity);
+    indices_.reserve(capacity);
+    frames_.push_back({root, kNoParent, 0, Isometry::kIdentity, 0});
+    indices_.emplace(root, 0);
+    std::size_t slots = 1;
+    while (slots < capacity) {
+      slots *= 2;
+    }
+    cache_.resize(slots);
+    clearCache();
+  }
+
+  FrameTree::FrameTree(const FrameTree& tree) :
+    serial_{nextSerial()}, frames_{tree.frames_}, indices_{tree.indices_},
+    cache_{tree.cache_}, hits_{tree.hits_}, misses_{tree.misses_} {}
+
+  FrameTree& FrameTree::operator=(const FrameTree& tree) {
+    if (this != &tree) {
+      serial_ = nextSerial();
+      frames_ = tree.frames_;
+      indices_ = tree.indices_;
+      cache_ = tree.cache_;
+      hits_ = tree.hits_;
+      misses_ = tree.misses_;
+    }
+    return *this;
+  }
+
+  bool FrameId::operator==(const FrameId& id1) const {
+    return index_ == id1.index_ && tree_ == id1.tree_;
+  }
+
+  bool FrameId::operator!=(const FrameId& id1) const {
+    return !(*this == id1);
+  }
+
+  std::size_t FrameId::index() const {
+    return index_;
+  }
+
+  bool FrameId::valid() const {
+    return *this != FrameId();
+  }
+
+  FrameId FrameTree::addFrame(const std::string& frame,
+                              const std::string& parent,
+                              const Isometry& transform) {
+    return addFrame(frame, id(parent), transform);
+  }
+
+  FrameId FrameTree::addFrame(const std::string& frame, const FrameId parent,
+                              const Isometry& transform) {
+    if (contains(frame)) {
+      throw std::invalid_argument("Frame " + frame + " already exists");
+    }
+    const std::size_t parent_index = index(parent);
+    const FrameId added(frames_.size(), serial_);
+    indices_.emplace(frame, added.index_);
+    frames_.push_back({frame, parent_index, frames_[parent_index].depth + 1,
+                       transform, 0});
+    return added;
+  }
+
+  void FrameTree::setTransform(const std::string& frame,
+                               const Isometry& transform) {
+    setTransform(id(frame), transform);
+  }
+
+  void FrameTree::setTransform(const FrameId frame,
+                               const Isometry& transform) {
+    if (index(frame) == 0) {
+      throw std::invalid_argument("The root frame has no parent");
+    }
+    Frame& edge = frames_[frame.index_];
+    edge.transform = transform;
+    ++edge.version;
+  }
+
+  FrameId FrameTree::id(const std::string& frame) const {
+    const auto it = indices_.find(frame);
+    if (it == indices_.end()) {
+      throw std::out_of_range("Unknown frame " + frame);
+    }
+    return FrameId(it->second, serial_);
+  }
+
+  const std::string& FrameTree::name(const FrameId frame) const {
+    return frames_[index(frame)].name;
+  }
+
+  const std::string& FrameTree::root() const {
+    return frames_[0].name;
+  }
+
+  std::size_t FrameTree::size() const {
+    return frames_.size();
+  }
+
+  bool FrameTree::contains(const std::string& frame) const {
+    return indices_.count(frame) > 0;
+  }
+
+  FrameId FrameTree::parent(const FrameId frame) const {
+    return FrameId(frames_[child(frame)].parent, serial_);
+  }
+
+  const std::string& FrameTree::parent(const std::string& frame) const {
+    return frames_[parent(id(frame)).index_].name;
+  }
+
+  const Isometry& FrameTree::transform(const FrameId frame) const {
+    return frames_[child(frame)].transform;
+  }
+
+  const Isometry& FrameTree::transform(const std::string& frame) const {
+    return transform(id(frame));
+  }
+
+  Isometry FrameTree::lookup(const std::string& target,
+                             const std::string& source) const {
+    return lookup(id(target), id(source));
+  }
+
+  Isometry FrameTree::lookup(const FrameId target,
+                             const FrameId source) const {
+    return compose(index(target), index(source));
+  }
+
+  Isometry FrameTree::cachedLookup(const std::string& target,
+                                   const std::string& source) {
+    return cachedLookup(id(target), id(source));
+  }
+
+  Isometry FrameTree::cachedLookup(const FrameId target_id,
+                                   const FrameId source_id) {
+    const std::size_t target = index(target_id);
+    const std::size_t source = index(source_id);
+    if (target == source) {
+      return Isometry::kIdentity;
+    }
+    const bool reversed = target > source;
+    const std::size_t first = reversed ? source : target;
+    const std::size_t second = reversed ? target : source;
+    const std::uint64_t key =
+        (static_cast<std::uint64_t>(first) << 32) | second;
+    CacheEntry& entry =
+        cache_[((key * kHashMultiplier) >> 32) & (cache_.size() - 1)];
+    const std::uint64_t path_version = version(first, second);
+    if (entry.first != first || entry.second != second ||
+        entry.version != path_version) {
+      ++misses_;
+      entry = {first, second, path_version, compose(first, second)};
+    } else {
+      ++hits_;
+    }
+    return reversed ? entry.transform.inverse() : entry.transform;
+  }
+
+  std::size_t FrameTree::cacheHits() const {
+    return hits_;
+  }
+
+  std::size_t FrameTree::cacheMisses() const {
+    return misses_;
+  }
+
+  double FrameTree::cacheHitRate() const {
+    const std::size_t lookups = hits_ + misses_;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits_) / lookups;
+  }
+
+  void FrameTree::resetCacheCounters() {
+    hits_ = 0;
+    misses_ = 0;
+  }
+
+  void FrameTree::clearCache() {
+    for (CacheEntry& entry : cache_) {
+      entry.first = kNoParent;
+    }
+  }
+
+  std::size_t FrameTree::index(const FrameId frame) const {
+    if (frame.tree_ != serial_ || frame.index_ >= frames_.size()) {
+      throw std::out_of_range("Unknown frame id");
+    }
+    return frame.index_;
+  }
+
+  std::size_t FrameTree::child(const FrameId frame) const {
+    const std::size_t i = index(frame);
+    if (i == 0) {
+      throw std::out_of_range("The root frame has no parent");
+    }
+    return i;
+  }
+
+  Isometry FrameTree::compose(std::size_t target, std::size_t source) const {
+    if (target == source) {
+      return Isometry::kIdentity;
+    }
+    // ancestor_T_target and ancestor_T_source, for the ancestors reached.
+    Isometry up_target = Isometry::kIdentity;
+    Isometry up_source = Isometry::kIdentity;
+    while (frames_[target].depth > frames_[source].depth) {
+      up_target = frames_[target].transform * up_target;
+      target = frames_[target].parent;
+    }
+    while (frames_[source].depth > frames_[target].depth) {
+      up_source = frames_[source].transform * up_source;
+      source = frames_[source].parent;
+    }
+    while (target != source) {
+      up_target = frames_[target].transform * up_target;
+      target = frames_[target].parent;
+      up_source = frames_[source].transform * up_source;
+      source = frames_[source].parent;
+    }
+    return up_target.inverse() * up_source;
+  }
+
+  std::uint64_t FrameTree::version(std::size_t target,
+                                   std::size_t source) const {
+    // Same walk as compose(). Versions only grow, so the sum changes
+    // whenever an edge on the path does.
+    std::uint64_t sum = 0;
+    while (frames_[target].depth > frames_[source].depth) {
+      sum += frames_[target].version;
+      target = frames_[target].parent;
+    }
+    while (frames_[source].depth > frames_[target].depth) {
+      sum += frames_[source].version;
+      source = frames_[source].parent;
+    }
+    while (target != source) {
+      sum += frames_[target].version + frames_[source].version;
+      target = frames_[target].parent;
+      source = frames_[source].parent;
+    }
+    return sum;
+  }
+
+}  // namespace math
+}  // namespace ekumen
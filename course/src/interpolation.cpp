@@ -0,0 +1,151 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/interpolation.hpp>
+
+#include <cmath>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  // Rotation matrix of q / |q|. Dividing by |q|^2 once instead of
+  // normalizing q saves the square root.
+  Matrix3 rotationMatrix(const Quaternion& q) {
+    const double s = 2.0 / q.dot(q);
+    const double xx = q.x() * q.x();
+    const double yy = q.y() * q.y();
+    const double zz = q.z() * q.z();
+    const double xy = q.x() * q.y();
+    const double xz = q.x() * q.z();
+    const double yz = q.y() * q.z();
+    const double wx = q.w() * q.x();
+    const double wy = q.w() * q.y();
+    const double wz = q.w() * q.z();
+    return Matrix3(
+      1.0 - s * (yy + zz), s * (xy - wz), s * (xz + wy),
+      s * (xy + wz), 1.0 - s * (xx + zz), s * (yz - wx),
+      s * (xz - wy), s * (yz + wx), 1.0 - s * (xx + yy));
+  }
+
+}  // namespace
+
+  double nlerpErrorBound(const double angle) {
+    const double square = angle * angle;
+    return std::sqrt(3.0) / 432.0 * square * angle * (1.0 + square / 48.0);
+  }
+
+  IsometryInterpolator::IsometryInterpolator(const Isometry& start,
+                                             const Isometry& end,
+                                             const Interpolation mode) :
+    mode_{mode}, start_{start},
+    twist_{mode == Interpolation::kScrew ?
+               logSE3(start.inverse() * end) : Twist()},
+    start_rotation_{Quaternion::fromRotationMatrix(start.rotation())},
+    end_rotation_{Quaternion::fromRotationMatrix(end.rotation())},
+    start_translation_{start.translation()},
+    delta_translation_{end.translation() - start.translation()} {
+    if (start_rotation_.dot(end_rotation_) < 0.0) {
+      end_rotation_ = end_rotation_ * -1.0;
+    }
+    const Quaternion relative =
+        start_rotation_.conjugate().product(end_rotation_);
+    half_angle_ = std::atan2(relative.vec().norm(), relative.w());
+    sin_half_angle_ = std::sin(half_angle_);
+  }
+
+  Interpolation IsometryInterpolator::mode() const {
+    return mode_;
+  }
+
+  double IsometryInterpolator::angle() const {
+    return 2.0 * half_angle_;
+  }
+
+  Isometry IsometryInterpolator::evaluate(const double t) const {
+    switch (mode_) {
+      case Interpolation::kScrew:
+        return screw(t);
+      case Interpolation::kSlerp:
+        return slerp(t);
+      default:
+        return nlerp(t);
+    }
+  }
+
+  void IsometryInterpolator::evaluate(const double* ts, Isometry* results,
+                                      const std::size_t count) const {
+    // One loop per mode keeps the dispatch out of the loop.
+    switch (mode_) {
+      case Interpolation::kScrew:
+        for (std::size_t i = 0; i < count; ++i) {
+          results[i] = screw(ts[i]);
+        }
+        break;
+      case Interpolation::kSlerp:
+        for (std::size_t i = 0; i < count; ++i) {
+          results[i] = slerp(ts[i]);
+        }
+        break;
+      default:
+        for (std::size_t i = 0; i < count; ++i) {
+          results[i] = nlerp(ts[i]);
+        }
+        break;
+    }
+  }
+
+  Isometry IsometryInterpolator::screw(const double t) const {
+    return start_ * expSE3(twist_ * t);
+  }
+
+  void IsometryInterpolator::slerpParts(const double t, Quaternion* rotation,
+                                        Vector3* translation) const {
+    double start_weight;
+    double end_weight;
+    if (half_angle_ < kSmallAngle) {
+      // sin(x * a) / sin(a) = x * (1 + (1 - x^2) * a^2 / 6 + ...), the
+      // rest is absorbed by the normalization.
+      const double square = half_angle_ * half_angle_;
+      const double s = 1.0 - t;
+      start_weight = s * (1.0 + (1.0 - s * s) * square / 6.0);
+      end_weight = t * (1.0 + (1.0 - t * t) * square / 6.0);
+    } else {
+      start_weight = std::sin((1.0 - t) * half_angle_) / sin_half_angle_;
+      end_weight = std::sin(t * half_angle_) / sin_half_angle_;
+    }
+    *rotation = start_rotation_ * start_weight + end_rotation_ * end_weight;
+    *translation = translationAt(t);
+  }
+
+  Isometry IsometryInterpolator::slerp(const double t) const {
+    Quaternion rotation;
+    Vector3 translation;
+    slerpParts(t, &rotation, &translation);
+    return {translation, rotationMatrix(rotation)};
+  }
+
+  Isometry IsometryInterpolator::nlerp(const double t) const {
+    return {translationAt(t),
+            rotationMatrix(start_rotation_ * (1.0 - t) + end_rotation_ * t)};
+  }
+
+  Vector3 IsometryInterpolator::translationAt(const double t) const {
+    return Vector3(start_translation_.x() + t * delta_translation_.x(),
+                   start_translation_.y() + t * delta_translation_.y(),
+                   start_translation_.z() + t * delta_translation_.z());
+  }
+
+  Isometry interpolate(const Isometry& start, const Isometry& end,
+                       const double t, const Interpolation mode) {
+    return IsometryInterpolator(start, end, mode).evaluate(t);
+  }
+
+}  // namespace math
+}  // namespace ekumen
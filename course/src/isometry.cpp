@@ -7,178 +7,476 @@
 // Copyright 2020, Blast545
 
 #include <isometry/isometry.hpp>
+#include <isometry/svd.hpp>
+
+#include <algorithm>
+#include <iomanip>
 
 namespace ekumen {
 namespace math {
 
-  // Used for double comparison, not public
-  static bool cmpf(double A, double B, double epsilon) {
-    return (fabs(A - B) < epsilon);
+  Vector3::Vector3(std::initializer_list<double> values) {
+    if (values.size() != 3) {
+      throw std::invalid_argument("Vector3 needs exactly 3 values");
+    }
+    const double* value = values.begin();
+    values_(0, 0) = value[0];
+    values_(1, 0) = value[1];
+    values_(2, 0) = value[2];
   }
 
-  Vector3::Vector3(double x, double y, double z) :
-    x_{x}, y_{y}, z_{z} {}
-
-  Vector3::Vector3() :
-    x_{0.0}, y_{0.0}, z_{0.0} {}
-
   double Vector3::norm() const {
     return sqrt(dot(*this));
   }
 
-  double Vector3::x() const {
-    return x_;
+  double & Vector3::x() & {
+    return values_(0, 0);
   }
 
-  double & Vector3::x() {
-    return x_;
+  double & Vector3::y() & {
+    return values_(1, 0);
   }
 
-  double Vector3::y() const {
-    return y_;
+  double & Vector3::z() & {
+    return values_(2, 0);
   }
 
-  double & Vector3::y() {
-    return y_;
+  bool Vector3::operator==(const Vector3& vector1) const {
+    return values_ == vector1.values_;
   }
 
-  double Vector3::z() const {
-    return z_;
+  bool Vector3::operator!=(const Vector3& vector1) const {
+    return values_ != vector1.values_;
+  }
+
+  Vector3 Vector3::operator*(const Vector3& vector1) const {
+    return Vector3(values_ * vector1.values_);
   }
 
-  double & Vector3::z() {
-    return z_;
+  Vector3 Vector3::operator/(const Vector3& vector1) const {
+    return Vector3(values_ / vector1.values_);
   }
 
-  double Vector3::dot(const Vector3& vector1) const {
-    return x_*vector1.x() + y_*vector1.y() + z_*vector1.z();
+  Vector3 Vector3::operator/(const double divider) const {
+    return Vector3(values_ / divider);
   }
 
-  Vector3 Vector3::cross(const Vector3& vector1) const {
-    return {
-            y_*vector1.z() - z_*vector1.y(),
-            z_*vector1.x() - x_*vector1.z(),
-            x_*vector1.y() - y_*vector1.x()};
+  Vector3& Vector3::operator+=(const Vector3& vector1) {
+    values_ += vector1.values_;
+    return *this;
   }
 
-  bool Vector3::operator==(const Vector3& vector1) const {
-    return(
-      cmpf(x_, vector1.x_, 0.00001f) &&
-      cmpf(y_, vector1.y_, 0.00001f) &&
-      cmpf(z_, vector1.z_, 0.00001f));
+  Vector3& Vector3::operator-=(const Vector3& vector1) {
+    values_ -= vector1.values_;
+    return *this;
   }
 
-  bool Vector3::operator!=(const Vector3& vector1) const {
-    return(!(
-      cmpf(x_, vector1.x_, 0.00001f) &&
-      cmpf(y_, vector1.y_, 0.00001f) &&
-      cmpf(z_, vector1.z_, 0.00001f)));
+  Vector3& Vector3::operator*=(const Vector3& vector1) {
+    values_ *= vector1.values_;
+    return *this;
   }
 
-  Vector3 Vector3::operator+(const Vector3& vector1) const {
-    return {x_+vector1.x_, y_+vector1.y_, z_+vector1.z_};
+  Vector3& Vector3::operator/=(const Vector3& vector1) {
+    values_ /= vector1.values_;
+    return *this;
   }
 
-  Vector3 Vector3::operator-(const Vector3& vector1) const {
-    return {x_-vector1.x_, y_-vector1.y_, z_-vector1.z_};
+  Vector3& Vector3::operator*=(const double scalar) {
+    values_ *= scalar;
+    return *this;
   }
 
-  Vector3 Vector3::operator*(const Vector3& vector1) const {
-    return {x_*vector1.x_, y_*vector1.y_, z_*vector1.z_};
+  Vector3& Vector3::operator/=(const double scalar) {
+    values_ /= scalar;
+    return *this;
   }
 
-  Vector3 Vector3::operator/(const Vector3& vector1) const {
-    return {x_/vector1.x_, y_/vector1.y_, z_/vector1.z_};
+  const Vector3 operator*(const Vector3& vector1, const double scalar) {
+    Vector3 result(vector1);
+    return result *= scalar;
   }
 
-  Vector3 Vector3::operator/(const double divider) const {
-    return {x_/divider, y_/divider, z_/divider};
+  const Vector3 operator*(const double scalar, const Vector3& vector1) {
+    Vector3 result(vector1);
+    return result *= scalar;
   }
 
-  Vector3& Vector3::operator+=(const Vector3& vector1) {
-    x_ += vector1.x_;
-    y_ += vector1.y_;
-    z_ += vector1.z_;
+  double & Vector3::operator[](int index) & {
+    if (index<0 || index>2) {
+      throw std::out_of_range("Index out of range");
+    }
+    return values_(index, 0);
+  }
+
+  std::ostream& operator<<(std::ostream &ss, const Vector3& vector1) {
+    ss << "(x: " << vector1.x()
+       << ", y: " << vector1.y()
+       << ", z: " << vector1.z()
+       << ")";
+    return ss;
+  }
+
+  constexpr Vector3 Vector3::kUnitX = Vector3(1.0, 0.0, 0.0);
+  constexpr Vector3 Vector3::kUnitY = Vector3(0.0, 1.0, 0.0);
+  constexpr Vector3 Vector3::kUnitZ = Vector3(0.0, 0.0, 1.0);
+  constexpr Vector3 Vector3::kZero = Vector3(0.0, 0.0, 0.0);
+
+  Matrix3::Matrix3(std::initializer_list<double> values) {
+    if (values.size() != 9) {
+      throw std::invalid_argument("Matrix3 needs exactly 9 values");
+    }
+    int index = 0;
+    for (const double value : values) {
+      rows_[index / 3][index % 3] = value;
+      ++index;
+    }
+  }
+
+  Matrix3::Matrix3(const MatrixN<3, 3>& values) :
+    Matrix3(values(0, 0), values(0, 1), values(0, 2),
+            values(1, 0), values(1, 1), values(1, 2),
+            values(2, 0), values(2, 1), values(2, 2)) {}
+
+  MatrixN<3, 3> Matrix3::matrix() const {
+    return MatrixN<3, 3>(
+      rows_[0].x(), rows_[0].y(), rows_[0].z(),
+      rows_[1].x(), rows_[1].y(), rows_[1].z(),
+      rows_[2].x(), rows_[2].y(), rows_[2].z());
+  }
+
+  Matrix3 Matrix3::inverse() const {
+    Matrix3 result;
+    if (!tryInverse(&result)) {
+      throw std::domain_error("Singular matrix has no inverse");
+    }
+    return result;
+  }
+
+  bool Matrix3::tryInverse(Matrix3* result) const {
+    double scale = 0.0;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        scale = std::max(scale, std::fabs(rows_[i][j]));
+      }
+    }
+    if (!(scale > 0.0)) {
+      return false;
+    }
+    // Works on the matrix divided by its largest entry, so that the
+    // determinant, a product of three entries, neither overflows nor
+    // underflows. Cofactor rows; det() is the dot product of the first one
+    // with row 0.
+    const Vector3 row0 = rows_[0] / scale;
+    const Vector3 row1 = rows_[1] / scale;
+    const Vector3 row2 = rows_[2] / scale;
+    const Vector3 cofactors0 = row1.cross(row2);
+    const Vector3 cofactors1 = row2.cross(row0);
+    const Vector3 cofactors2 = row0.cross(row1);
+    const double determinant = row0.dot(cofactors0);
+    // Written so that a NaN determinant is reported as singular too.
+    if (!(std::fabs(determinant) > kSingularityTolerance)) {
+      return false;
+    }
+    *result = Matrix3(
+      cofactors0.x(), cofactors1.x(), cofactors2.x(),
+      cofactors0.y(), cofactors1.y(), cofactors2.y(),
+      cofactors0.z(), cofactors1.z(), cofactors2.z());
+    *result *= 1.0 / determinant / scale;
+    return true;
+  }
+
+  std::size_t Matrix3::tryInverse(const Matrix3* matrices, Matrix3* results,
+                                  bool* invertible, const std::size_t count) {
+    std::size_t inverted = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      const bool ok = matrices[i].tryInverse(&results[i]);
+      if (!ok) {
+        results[i] = kZero;
+      } else {
+        ++inverted;
+      }
+      if (invertible != nullptr) {
+        invertible[i] = ok;
+      }
+    }
+    return inverted;
+  }
+
+  Matrix3& Matrix3::renormalize(const Renormalization mode) {
+    if (mode == Renormalization::kExact) {
+      *this = nearestRotation(*this);
+      return *this;
+    }
+    const double half_error = rows_[0].dot(rows_[1]) / 2.0;
+    const Vector3 row0 = rows_[0] - rows_[1] * half_error;
+    const Vector3 row1 = rows_[1] - rows_[0] * half_error;
+    rows_[0] = row0;
+    rows_[1] = row1;
+    rows_[2] = row0.cross(row1);
+    for (int i = 0; i < 3; ++i) {
+      rows_[i] *= (3.0 - rows_[i].dot(rows_[i])) / 2.0;
+    }
     return *this;
   }
 
-  Vector3& Vector3::operator-=(const Vector3& vector1) {
-    x_ -= vector1.x_;
-    y_ -= vector1.y_;
-    z_ -= vector1.z_;
+  bool Matrix3::operator==(const Matrix3& matrix1) const {
+    return(
+      rows_[0] == matrix1.rows_[0] &&
+      rows_[1] == matrix1.rows_[1] &&
+      rows_[2] == matrix1.rows_[2]);
+  }
+
+  bool Matrix3::operator!=(const Matrix3& matrix1) const {
+    return !(*this == matrix1);
+  }
+
+  Matrix3 Matrix3::operator+(const Matrix3& matrix1) const {
+    Matrix3 result(*this);
+    return result += matrix1;
+  }
+
+  Matrix3 Matrix3::operator-(const Matrix3& matrix1) const {
+    Matrix3 result(*this);
+    return result -= matrix1;
+  }
+
+  Matrix3 Matrix3::operator*(const Matrix3& matrix1) const {
+    Matrix3 result(*this);
+    return result *= matrix1;
+  }
+
+  Matrix3 Matrix3::operator/(const Matrix3& matrix1) const {
+    Matrix3 result(*this);
+    return result /= matrix1;
+  }
+
+  Matrix3& Matrix3::operator+=(const Matrix3& matrix1) {
+    for (int i = 0; i < 3; ++i) {
+      rows_[i] += matrix1.rows_[i];
+    }
     return *this;
   }
 
-  Vector3& Vector3::operator*=(const Vector3& vector1) {
-    x_ *= vector1.x_;
-    y_ *= vector1.y_;
-    z_ *= vector1.z_;
+  Matrix3& Matrix3::operator-=(const Matrix3& matrix1) {
+    for (int i = 0; i < 3; ++i) {
+      rows_[i] -= matrix1.rows_[i];
+    }
     return *this;
   }
 
-  Vector3& Vector3::operator/=(const Vector3& vector1) {
-    x_ /= vector1.x_;
-    y_ /= vector1.y_;
-    z_ /= vector1.z_;
+  Matrix3& Matrix3::operator*=(const Matrix3& matrix1) {
+    for (int i = 0; i < 3; ++i) {
+      rows_[i] *= matrix1.rows_[i];
+    }
     return *this;
   }
 
-  Vector3& Vector3::operator*=(const double scalar) {
-    x_ *= scalar;
-    y_ *= scalar;
-    z_ *= scalar;
+  Matrix3& Matrix3::operator/=(const Matrix3& matrix1) {
+    for (int i = 0; i < 3; ++i) {
+      rows_[i] /= matrix1.rows_[i];
+    }
     return *this;
   }
 
-  Vector3& Vector3::operator/=(const double scalar) {
-    x_ /= scalar;
-    y_ /= scalar;
-    z_ /= scalar;
+  Matrix3& Matrix3::operator*=(const double scalar) {
+    for (int i = 0; i < 3; ++i) {
+      rows_[i] *= scalar;
+    }
     return *this;
   }
 
-  const Vector3 operator*(const Vector3& vector1, const int scalar) {
-    return Vector3(vector1.x_*scalar, vector1.y_*scalar, vector1.z_*scalar);
+  Matrix3& Matrix3::operator/=(const double scalar) {
+    for (int i = 0; i < 3; ++i) {
+      rows_[i] /= scalar;
+    }
+    return *this;
+  }
+
+  const Matrix3 operator*(const Matrix3& matrix1, const double scalar) {
+    Matrix3 result(matrix1);
+    return result *= scalar;
   }
 
-  const Vector3 operator*(const int scalar, const Vector3& vector1) {
-    return Vector3(vector1.x_*scalar, vector1.y_*scalar, vector1.z_*scalar);
+  const Matrix3 operator*(const double scalar, const Matrix3& matrix1) {
+    Matrix3 result(matrix1);
+    return result *= scalar;
   }
 
-  double Vector3::operator[](int index) const {
+  Vector3& Matrix3::operator[](int index) & {
     if (index<0 || index>2) {
       throw std::out_of_range("Index out of range");
     }
-    if (index == 0) {
-      return x_;
-    } else if (index == 1) {
-      return y_;
-    } else {return z_;}
+    return rows_[index];
   }
 
-  double & Vector3::operator[](int index) {
-    if (index<0 || index>2) {
-      throw std::out_of_range("Index out of range");
+  std::ostream& operator<<(std::ostream &ss, const Matrix3& matrix1) {
+    ss << "[";
+    for (int i = 0; i < 3; ++i) {
+      ss << (i == 0 ? "[" : ", [")
+         << matrix1.rows_[i].x() << ", "
+         << matrix1.rows_[i].y() << ", "
+         << matrix1.rows_[i].z() << "]";
     }
-    if (index == 0) {
-      return x_;
-    } else if (index == 1) {
-      return y_;
-    } else {return z_;}
+    ss << "]";
+    return ss;
   }
 
-  std::ostream& operator<<(std::ostream &ss, const Vector3& vector1) {
-    ss << "(x: " << vector1.x_
-       << ", y: " << vector1.y_
-       << ", z: " << vector1.z_
-       << ")";
+  const double Matrix3::kSingularityTolerance = 1e-12;
+
+  constexpr Matrix3 Matrix3::kIdentity = Matrix3(1.0, 0.0, 0.0,
+                                             0.0, 1.0, 0.0,
+                                             0.0, 0.0, 1.0);
+  constexpr Matrix3 Matrix3::kOnes = Matrix3(1.0, 1.0, 1.0,
+                                         1.0, 1.0, 1.0,
+                                         1.0, 1.0, 1.0);
+  constexpr Matrix3 Matrix3::kZero = Matrix3(0.0, 0.0, 0.0,
+                                         0.0, 0.0, 0.0,
+                                         0.0, 0.0, 0.0);
+
+
+  Isometry Isometry::rotateAround(const Vector3& axis, const double angle) {
+    const double norm = axis.norm();
+    if (norm == 0.0) {
+      throw std::invalid_argument("Rotation axis must not be null");
+    }
+    // Rodrigues' formula: R = cos * I + sin * [k]x + (1 - cos) * k * k^T.
+    const Vector3 k = axis / norm;
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    const double t = 1.0 - c;
+    return {Vector3::kZero, Matrix3(
+      c + t * k.x() * k.x(), t * k.x() * k.y() - s * k.z(),
+      t * k.x() * k.z() + s * k.y(),
+      t * k.y() * k.x() + s * k.z(), c + t * k.y() * k.y(),
+      t * k.y() * k.z() - s * k.x(),
+      t * k.z() * k.x() - s * k.y(), t * k.z() * k.y() + s * k.x(),
+      c + t * k.z() * k.z())};
+  }
+
+  Isometry Isometry::fromEulerAngles(const double roll, const double pitch,
+                                     const double yaw) {
+    // Closed form of Rx(roll) * Ry(pitch) * Rz(yaw). Each sin and cos pair
+    // shares its argument, which lets the compiler emit a single sincos.
+    const double sa = std::sin(roll);
+    const double ca = std::cos(roll);
+    const double sb = std::sin(pitch);
+    const double cb = std::cos(pitch);
+    const double sc = std::sin(yaw);
+    const double cc = std::cos(yaw);
+    const double sa_sb = sa * sb;
+    const double ca_sb = ca * sb;
+    return {Vector3::kZero, Matrix3(
+      cb * cc, -cb * sc, sb,
+      sa_sb * cc + ca * sc, ca * cc - sa_sb * sc, -sa * cb,
+      sa * sc - ca_sb * cc, ca_sb * sc + sa * cc, ca * cb)};
+  }
+
+  void Isometry::fromEulerAngles(const Vector3* angles, Isometry* results,
+                                 const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      results[i] = fromEulerAngles(angles[i].x(), angles[i].y(),
+                                   angles[i].z());
+    }
+  }
+
+  Isometry Isometry::inverse() const {
+    const Matrix3 rotation = rotation_.transpose();
+    return {Vector3::kZero - rotation * translation_, rotation};
+  }
+
+  Matrix4 Isometry::matrix() const {
+    Matrix4 result = Matrix4::identity();
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        result(i, j) = rotation_[i][j];
+      }
+      result(i, 3) = translation_[i];
+    }
+    return result;
+  }
+
+  Isometry Isometry::compose(const Isometry& isometry1) const {
+    return {transform(isometry1.translation_),
+            rotation_.product(isometry1.rotation_)};
+  }
+
+  Isometry& Isometry::renormalize(const Renormalization mode) {
+    rotation_.renormalize(mode);
+    return *this;
+  }
+
+  bool Isometry::operator==(const Isometry& isometry1) const {
+    return translation_ == isometry1.translation_ &&
+           rotation_ == isometry1.rotation_;
+  }
+
+  bool Isometry::operator!=(const Isometry& isometry1) const {
+    return !(*this == isometry1);
+  }
+
+  Isometry Isometry::operator*(const Isometry& isometry1) const {
+    return compose(isometry1);
+  }
+
+  Vector3 Isometry::operator*(const Vector3& vector1) const {
+    return transform(vector1);
+  }
+
+  Isometry& Isometry::operator*=(const Isometry& isometry1) {
+    *this = compose(isometry1);
+    return *this;
+  }
+
+  std::ostream& operator<<(std::ostream &ss, const Isometry& isometry1) {
+    const std::streamsize precision = ss.precision();
+    ss << std::setprecision(9)
+       << "[T: " << isometry1.translation_
+       << ", R:" << isometry1.rotation_ << "]"
+       << std::setprecision(precision);
     return ss;
   }
 
-  const Vector3 Vector3::kUnitX = Vector3(1.0, 0.0, 0.0);
-  const Vector3 Vector3::kUnitY = Vector3(0.0, 1.0, 0.0);
-  const Vector3 Vector3::kUnitZ = Vector3(0.0, 0.0, 1.0);
-  const Vector3 Vector3::kZero = Vector3(0.0, 0.0, 0.0);
+  constexpr Isometry Isometry::kIdentity = Isometry(Vector3::kZero,
+                                                Matrix3::kIdentity);
+
+  RenormalizingIsometry::RenormalizingIsometry(const std::size_t period,
+                                               const Isometry& isometry) :
+    isometry_{isometry}, period_{period} {}
+
+  const Isometry& RenormalizingIsometry::isometry() const {
+    return isometry_;
+  }
+
+  std::size_t RenormalizingIsometry::period() const {
+    return period_;
+  }
+
+  std::size_t RenormalizingIsometry::compositions() const {
+    return compositions_;
+  }
+
+  RenormalizingIsometry& RenormalizingIsometry::renormalize(
+      const Renormalization mode) {
+    isometry_.renormalize(mode);
+    compositions_ = 0;
+    return *this;
+  }
+
+  RenormalizingIsometry RenormalizingIsometry::operator*(
+      const Isometry& isometry1) const {
+    RenormalizingIsometry result(*this);
+    return result *= isometry1;
+  }
+
+  RenormalizingIsometry& RenormalizingIsometry::operator*=(
+      const Isometry& isometry1) {
+    isometry_ = isometry_.compose(isometry1);
+    ++compositions_;
+    if (period_ != 0 && compositions_ >= period_) {
+      renormalize(Renormalization::kFast);
+    }
+    return *this;
+  }
 
 }  // namespace math
 }  // namespace ekumen
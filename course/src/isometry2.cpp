@@ -0,0 +1,172 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/isometry2.hpp>
+#include <isometry/constexpr_math.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  using internal::kPi;
+
+  // Maps angle into [-pi, pi].
+  double wrapAngle(const double angle) {
+    return std::remainder(angle, 2.0 * kPi);
+  }
+
+  // Maps the sum of two angles in [-pi, pi] back into [-pi, pi].
+  double wrapSum(const double angle) {
+    return angle > kPi ? angle - 2.0 * kPi :
+           angle < -kPi ? angle + 2.0 * kPi : angle;
+  }
+
+}  // namespace
+
+  Isometry2::Isometry2(const double x, const double y, const double theta) :
+    Isometry2(Vector2(x, y), theta) {}
+
+  Isometry2::Isometry2(const Vector2& translation, const double theta) :
+    Isometry2(translation, wrapAngle(theta), std::cos(theta),
+              std::sin(theta)) {}
+
+  Isometry Isometry2::toIsometry() const {
+    return {Vector3(x(), y(), 0.0),
+            Matrix3(cos_, -sin_, 0.0,
+                    sin_, cos_, 0.0,
+                    0.0, 0.0, 1.0)};
+  }
+
+  Isometry2 Isometry2::fromIsometry(const Isometry& isometry) {
+    const Matrix3& r = isometry.rotation();
+    const Isometry2 planar(Vector2(isometry.translation().x(),
+                                   isometry.translation().y()),
+                           std::atan2(r[1][0], r[0][0]), r[0][0], r[1][0]);
+    if (planar.toIsometry() != isometry) {
+      throw std::invalid_argument("Isometry is not planar");
+    }
+    return planar;
+  }
+
+  double Isometry2::x() const {
+    return translation_(0, 0);
+  }
+
+  double Isometry2::y() const {
+    return translation_(1, 0);
+  }
+
+  double Isometry2::theta() const {
+    return theta_;
+  }
+
+  double Isometry2::cos() const {
+    return cos_;
+  }
+
+  double Isometry2::sin() const {
+    return sin_;
+  }
+
+  const Vector2& Isometry2::translation() const {
+    return translation_;
+  }
+
+  Matrix2 Isometry2::rotation() const {
+    return Matrix2(cos_, -sin_, sin_, cos_);
+  }
+
+  Vector2 Isometry2::transform(const Vector2& vector1) const {
+    const double vx = vector1(0, 0);
+    const double vy = vector1(1, 0);
+    return Vector2(cos_ * vx - sin_ * vy + x(), sin_ * vx + cos_ * vy + y());
+  }
+
+  Vector2 Isometry2::inverseTransform(const Vector2& vector1) const {
+    const double dx = vector1(0, 0) - x();
+    const double dy = vector1(1, 0) - y();
+    return Vector2(cos_ * dx + sin_ * dy, cos_ * dy - sin_ * dx);
+  }
+
+  Isometry2 Isometry2::inverse() const {
+    return {Vector2(-cos_ * x() - sin_ * y(), sin_ * x() - cos_ * y()),
+            -theta_, cos_, -sin_};
+  }
+
+  Isometry2 Isometry2::compose(const Isometry2& isometry1) const {
+    const double c = cos_ * isometry1.cos_ - sin_ * isometry1.sin_;
+    const double s = sin_ * isometry1.cos_ + cos_ * isometry1.sin_;
+    // First order correction of c^2 + s^2 drift, as in Matrix3 kFast.
+    const double scale = (3.0 - c * c - s * s) / 2.0;
+    return {transform(isometry1.translation_),
+            wrapSum(theta_ + isometry1.theta_), c * scale, s * scale};
+  }
+
+  bool Isometry2::operator==(const Isometry2& isometry1) const {
+    return translation_ == isometry1.translation_ &&
+           Vector2(cos_, sin_) == Vector2(isometry1.cos_, isometry1.sin_);
+  }
+
+  bool Isometry2::operator!=(const Isometry2& isometry1) const {
+    return !(*this == isometry1);
+  }
+
+  Isometry2 Isometry2::operator*(const Isometry2& isometry1) const {
+    return compose(isometry1);
+  }
+
+  Vector2 Isometry2::operator*(const Vector2& vector1) const {
+    return transform(vector1);
+  }
+
+  Isometry2& Isometry2::operator*=(const Isometry2& isometry1) {
+    *this = compose(isometry1);
+    return *this;
+  }
+
+  std::ostream& operator<<(std::ostream &ss, const Isometry2& isometry1) {
+    ss << "[T: (x: " << isometry1.x()
+       << ", y: " << isometry1.y()
+       << "), theta: " << isometry1.theta_ << "]";
+    return ss;
+  }
+
+  constexpr Isometry2 Isometry2::kIdentity = Isometry2();
+
+  void transform(const Isometry2& isometry, const Vector2* points,
+                 Vector2* results, const std::size_t count) {
+    const double c = isometry.cos();
+    const double s = isometry.sin();
+    const double x = isometry.x();
+    const double y = isometry.y();
+    for (std::size_t i = 0; i < count; ++i) {
+      const double px = points[i](0, 0);
+      const double py = points[i](1, 0);
+      results[i] = Vector2(c * px - s * py + x, s * px + c * py + y);
+    }
+  }
+
+  void inverseTransform(const Isometry2& isometry, const Vector2* points,
+                        Vector2* results, const std::size_t count) {
+    const double c = isometry.cos();
+    const double s = isometry.sin();
+    const double x = isometry.x();
+    const double y = isometry.y();
+    for (std::size_t i = 0; i < count; ++i) {
+      const double dx = points[i](0, 0) - x;
+      const double dy = points[i](1, 0) - y;
+      results[i] = Vector2(c * dx + s * dy, c * dy - s * dx);
+    }
+  }
+
+}  // namespace math
+}  // namespace ekumen
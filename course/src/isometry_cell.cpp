@@ -0,0 +1,86 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/isometry_cell.hpp>
+
+#include <thread>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  // Failed reads before load() starts yielding, in case the writer was
+  // preempted in the middle of a store and needs this core to finish it.
+  const int kSpins = 64;
+
+}  // namespace
+
+  IsometryCell::IsometryCell(const Isometry& isometry) {
+    store(isometry);
+    sequence_.store(0, std::memory_order_relaxed);
+  }
+
+  void IsometryCell::store(const Isometry& isometry) {
+    const std::uint64_t sequence =
+        sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    // Release stores keep the odd sequence ahead of the payload. They are
+    // plain moves on x86, and unlike standalone fences TSan models them.
+    const Vector3& t = isometry.translation();
+    const Matrix3& r = isometry.rotation();
+    for (int i = 0; i < 3; ++i) {
+      words_[i].store(t[i], std::memory_order_release);
+      for (int j = 0; j < 3; ++j) {
+        words_[3 + 3 * i + j].store(r[i][j], std::memory_order_release);
+      }
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  Isometry IsometryCell::load() const {
+    Isometry result;
+    for (int attempt = 1; !read(&result); ++attempt) {
+      if (attempt >= kSpins) {
+        std::this_thread::yield();
+      }
+    }
+    return result;
+  }
+
+  bool IsometryCell::tryLoad(Isometry* result) const {
+    return read(result);
+  }
+
+  std::uint64_t IsometryCell::version() const {
+    return sequence_.load(std::memory_order_acquire) / 2;
+  }
+
+  bool IsometryCell::read(Isometry* result) const {
+    const std::uint64_t before = sequence_.load(std::memory_order_acquire);
+    if (before & 1) {
+      return false;
+    }
+    double w[kWords];
+    // Acquire loads keep the second sequence read behind the payload: a
+    // word from a newer store makes that store's odd sequence visible.
+    for (std::size_t i = 0; i < kWords; ++i) {
+      w[i] = words_[i].load(std::memory_order_acquire);
+    }
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    *result = Isometry(Vector3(w[0], w[1], w[2]),
+                       Matrix3(w[3], w[4], w[5],
+                               w[6], w[7], w[8],
+                               w[9], w[10], w[11]));
+    return true;
+  }
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,170 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/large_world.hpp>
+
+#include <iomanip>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  Matrix3f toFloat(const Matrix3& matrix) {
+    Matrix3f result;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        result(i, j) = static_cast<float>(matrix[i][j]);
+      }
+    }
+    return result;
+  }
+
+  Matrix3 toDouble(const Matrix3f& matrix) {
+    return Matrix3(matrix(0, 0), matrix(0, 1), matrix(0, 2),
+                   matrix(1, 0), matrix(1, 1), matrix(1, 2),
+                   matrix(2, 0), matrix(2, 1), matrix(2, 2));
+  }
+
+  // rotation * (x, y, z) accumulated in double.
+  Vector3 rotate(const Matrix3f& rotation, double x, double y, double z) {
+    return Vector3(rotation(0, 0) * x + rotation(0, 1) * y +
+                   rotation(0, 2) * z,
+                   rotation(1, 0) * x + rotation(1, 1) * y +
+                   rotation(1, 2) * z,
+                   rotation(2, 0) * x + rotation(2, 1) * y +
+                   rotation(2, 2) * z);
+  }
+
+  Vector3f toFloat(const Vector3& vector1) {
+    return Vector3f(vector1.x(), vector1.y(), vector1.z());
+  }
+
+}  // namespace
+
+  LargeWorldIsometry::LargeWorldIsometry(const Vector3& translation,
+                                         const Matrix3f& rotation) :
+    translation_{translation}, rotation_{rotation} {}
+
+  LargeWorldIsometry::LargeWorldIsometry() :
+    rotation_{Matrix3f::identity()} {}
+
+  LargeWorldIsometry::LargeWorldIsometry(const Isometry& isometry) :
+    translation_{isometry.translation()},
+    rotation_{toFloat(isometry.rotation())} {}
+
+  Isometry LargeWorldIsometry::toIsometry() const {
+    return {translation_, toDouble(rotation_)};
+  }
+
+  const Vector3& LargeWorldIsometry::translation() const {
+    return translation_;
+  }
+
+  const Matrix3f& LargeWorldIsometry::rotation() const {
+    return rotation_;
+  }
+
+  Vector3 LargeWorldIsometry::transform(const Vector3& vector1) const {
+    return rotate(rotation_, vector1.x(), vector1.y(), vector1.z()) +
+           translation_;
+  }
+
+  Vector3 LargeWorldIsometry::transform(const Vector3f& vector1) const {
+    return rotate(rotation_, vector1(0, 0), vector1(1, 0), vector1(2, 0)) +
+           translation_;
+  }
+
+  LargeWorldIsometry LargeWorldIsometry::inverse() const {
+    const Matrix3f rotation = rotation_.transpose();
+    return {Vector3::kZero - rotate(rotation, translation_.x(),
+                                    translation_.y(), translation_.z()),
+            rotation};
+  }
+
+  LargeWorldIsometry LargeWorldIsometry::compose(
+      const LargeWorldIsometry& isometry1) const {
+    return {transform(isometry1.translation_),
+            toFloat(toDouble(rotation_).product(
+                toDouble(isometry1.rotation_)))};
+  }
+
+  bool LargeWorldIsometry::operator==(
+      const LargeWorldIsometry& isometry1) const {
+    return translation_ == isometry1.translation_ &&
+           rotation_ == isometry1.rotation_;
+  }
+
+  bool LargeWorldIsometry::operator!=(
+      const LargeWorldIsometry& isometry1) const {
+    return !(*this == isometry1);
+  }
+
+  LargeWorldIsometry LargeWorldIsometry::operator*(
+      const LargeWorldIsometry& isometry1) const {
+    return compose(isometry1);
+  }
+
+  Vector3 LargeWorldIsometry::operator*(const Vector3& vector1) const {
+    return transform(vector1);
+  }
+
+  Vector3 LargeWorldIsometry::operator*(const Vector3f& vector1) const {
+    return transform(vector1);
+  }
+
+  std::ostream& operator<<(std::ostream &ss,
+                           const LargeWorldIsometry& isometry1) {
+    const std::streamsize precision = ss.precision();
+    ss << std::setprecision(9)
+       << "[T: " << isometry1.translation_
+       << ", R:" << isometry1.rotation_ << "]"
+       << std::setprecision(precision);
+    return ss;
+  }
+
+  LocalOrigin::LocalOrigin(const Vector3& origin) : origin_{origin} {}
+
+  const Vector3& LocalOrigin::origin() const {
+    return origin_;
+  }
+
+  Vector3f LocalOrigin::toLocal(const Vector3& world) const {
+    return toFloat(world - origin_);
+  }
+
+  Vector3 LocalOrigin::toWorld(const Vector3f& local) const {
+    return Vector3(local(0, 0), local(1, 0), local(2, 0)) + origin_;
+  }
+
+  void LocalOrigin::transform(const LargeWorldIsometry& pose,
+                              const Vector3f* points, Vector3f* results,
+                              const std::size_t count) const {
+    // The pose translation relative to the origin is small, so the
+    // cancellation against origin_ happens once, in double.
+    const Vector3 offset = pose.translation() - origin_;
+    for (std::size_t i = 0; i < count; ++i) {
+      const Vector3f& point = points[i];
+      results[i] = toFloat(rotate(pose.rotation(), point(0, 0), point(1, 0),
+                                  point(2, 0)) + offset);
+    }
+  }
+
+  void LocalOrigin::rebase(const Vector3& origin, Vector3f* points,
+                           const std::size_t count) {
+    const Vector3 shift = origin_ - origin;
+    for (std::size_t i = 0; i < count; ++i) {
+      Vector3f& point = points[i];
+      point = Vector3f(point(0, 0) + shift.x(), point(1, 0) + shift.y(),
+                       point(2, 0) + shift.z());
+    }
+    origin_ = origin;
+  }
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,200 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/lie.hpp>
+
+#include <cmath>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  // Below this cosine the logarithm reads the axis from the symmetric part
+  // of the rotation, since dividing by sin(angle) loses precision.
+  const double kNearHalfTurnCos = -0.9;
+
+  // Rodrigues coefficients sin(x) / x, (1 - cos(x)) / x^2 and
+  // (x - sin(x)) / x^3, with x^2 = square.
+  struct Coefficients {
+    double a;
+    double b;
+    double c;
+  };
+
+  Coefficients coefficients(const double square) {
+    if (square < kSmallAngle * kSmallAngle) {
+      return {1.0 - square / 6.0 + square * square / 120.0,
+              0.5 - square / 24.0 + square * square / 720.0,
+              1.0 / 6.0 - square / 120.0 + square * square / 5040.0};
+    }
+    const double angle = std::sqrt(square);
+    const double sin = std::sin(angle);
+    const double cos = std::cos(angle);
+    return {sin / angle, (1.0 - cos) / square,
+            (angle - sin) / (square * angle)};
+  }
+
+  // I + a * [omega]x + b * [omega]x^2.
+  Matrix3 rodrigues(const Vector3& omega, const double square,
+                    const double a, const double b) {
+    const double x = omega.x();
+    const double y = omega.y();
+    const double z = omega.z();
+    return Matrix3(
+      1.0 + b * (x * x - square), b * x * y - a * z, b * x * z + a * y,
+      b * x * y + a * z, 1.0 + b * (y * y - square), b * y * z - a * x,
+      b * x * z - a * y, b * y * z + a * x, 1.0 + b * (z * z - square));
+  }
+
+}  // namespace
+
+  Vector6 Twist::vector() const {
+    return Vector6(linear.x(), linear.y(), linear.z(),
+                   angular.x(), angular.y(), angular.z());
+  }
+
+  Twist Twist::fromVector(const Vector6& vector1) {
+    return {Vector3(vector1(0, 0), vector1(1, 0), vector1(2, 0)),
+            Vector3(vector1(3, 0), vector1(4, 0), vector1(5, 0))};
+  }
+
+  bool Twist::operator==(const Twist& twist1) const {
+    return linear == twist1.linear && angular == twist1.angular;
+  }
+
+  bool Twist::operator!=(const Twist& twist1) const {
+    return !(*this == twist1);
+  }
+
+  Twist Twist::operator+(const Twist& twist1) const {
+    return {linear + twist1.linear, angular + twist1.angular};
+  }
+
+  Twist Twist::operator-(const Twist& twist1) const {
+    return {linear - twist1.linear, angular - twist1.angular};
+  }
+
+  Twist Twist::operator*(const double scalar) const {
+    return {linear * scalar, angular * scalar};
+  }
+
+  std::ostream& operator<<(std::ostream &ss, const Twist& twist1) {
+    ss << "[v: " << twist1.linear << ", w: " << twist1.angular << "]";
+    return ss;
+  }
+
+  Matrix3 expSO3(const Vector3& omega) {
+    const double square = omega.dot(omega);
+    const Coefficients k = coefficients(square);
+    return rodrigues(omega, square, k.a, k.b);
+  }
+
+  Vector3 logSO3(const Matrix3& rotation) {
+    // sin(angle) * axis, from the skew-symmetric part.
+    const Vector3 s(0.5 * (rotation[2][1] - rotation[1][2]),
+                    0.5 * (rotation[0][2] - rotation[2][0]),
+                    0.5 * (rotation[1][0] - rotation[0][1]));
+    const double sin = s.norm();
+    const double cos = 0.5 * (rotation[0][0] + rotation[1][1] +
+                              rotation[2][2] - 1.0);
+    const double angle = std::atan2(sin, cos);
+    if (angle < kSmallAngle) {
+      // angle / sin(angle) = 1 + x^2 / 6 + 7 x^4 / 360 + ...
+      const double square = angle * angle;
+      const double factor = 1.0 + square / 6.0 + 7.0 * square * square / 360.0;
+      return s * factor;
+    }
+    if (cos > kNearHalfTurnCos) {
+      const double factor = angle / sin;
+      return s * factor;
+    }
+    // (R + R^T) / 2 - cos * I = (1 - cos) * axis * axis^T. Read the axis
+    // from the column with the largest diagonal entry.
+    int i = 0;
+    for (int j = 1; j < 3; ++j) {
+      if (rotation[j][j] > rotation[i][i]) {
+        i = j;
+      }
+    }
+    const double scale = 1.0 - cos;
+    Vector3 axis;
+    for (int j = 0; j < 3; ++j) {
+      axis[j] = 0.5 * (rotation[j][i] + rotation[i][j]) / scale;
+    }
+    axis[i] -= cos / scale;
+    const double factor = (axis.dot(s) < 0.0 ? -angle : angle) / axis.norm();
+    return axis * factor;
+  }
+
+  Isometry expSE3(const Twist& twist) {
+    const Vector3& omega = twist.angular;
+    const double square = omega.dot(omega);
+    const Coefficients k = coefficients(square);
+    // V * v = v + b * omega x v + c * omega x (omega x v).
+    const Vector3 cross = omega.cross(twist.linear);
+    const Vector3 cross2 = omega.cross(cross);
+    return {twist.linear + cross * k.b + cross2 * k.c,
+            rodrigues(omega, square, k.a, k.b)};
+  }
+
+  Twist logSE3(const Isometry& isometry) {
+    const Vector3 omega = logSO3(isometry.rotation());
+    const double square = omega.dot(omega);
+    // V^-1 = I - [omega]x / 2 + d * [omega]x^2.
+    double d;
+    if (square < kSmallAngle * kSmallAngle) {
+      d = 1.0 / 12.0 + square / 720.0 + square * square / 30240.0;
+    } else {
+      const double angle = std::sqrt(square);
+      d = (1.0 - angle * std::sin(angle) / (2.0 * (1.0 - std::cos(angle)))) /
+          square;
+    }
+    const Vector3& t = isometry.translation();
+    const Vector3 cross = omega.cross(t);
+    const Vector3 cross2 = omega.cross(cross);
+    return {t - cross * 0.5 + cross2 * d, omega};
+  }
+
+  Twist adjoint(const Isometry& isometry, const Twist& twist) {
+    const Vector3 angular = isometry.rotation() * twist.angular;
+    return {isometry.rotation() * twist.linear +
+                isometry.translation().cross(angular),
+            angular};
+  }
+
+  void expSO3(const Vector3* omegas, Matrix3* results,
+              const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      results[i] = expSO3(omegas[i]);
+    }
+  }
+
+  void logSO3(const Matrix3* rotations, Vector3* results,
+              const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      results[i] = logSO3(rotations[i]);
+    }
+  }
+
+  void expSE3(const Twist* twists, Isometry* results,
+              const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      results[i] = expSE3(twists[i]);
+    }
+  }
+
+  void logSE3(const Isometry* isometries, Twist* results,
+              const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      results[i] = logSE3(isometries[i]);
+    }
+  }
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,229 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/quaternion.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+  Quaternion Quaternion::fromAxisAngle(const Vector3& axis,
+                                       const double angle) {
+    const double norm = axis.norm();
+    if (norm == 0.0) {
+      throw std::invalid_argument("Rotation axis must not be null");
+    }
+    const double scale = std::sin(angle / 2.0) / norm;
+    return {std::cos(angle / 2.0), axis.x() * scale, axis.y() * scale,
+            axis.z() * scale};
+  }
+
+  Quaternion Quaternion::fromRotationMatrix(const Matrix3& rotation) {
+    // Shepperd's method: divide by the largest of the four candidates.
+    const double m00 = rotation[0][0];
+    const double m11 = rotation[1][1];
+    const double m22 = rotation[2][2];
+    const double trace = m00 + m11 + m22;
+    Quaternion result;
+    if (trace > 0.0) {
+      const double s = 2.0 * std::sqrt(trace + 1.0);
+      result = {s / 4.0, (rotation[2][1] - rotation[1][2]) / s,
+                (rotation[0][2] - rotation[2][0]) / s,
+                (rotation[1][0] - rotation[0][1]) / s};
+    } else if (m00 > m11 && m00 > m22) {
+      const double s = 2.0 * std::sqrt(1.0 + m00 - m11 - m22);
+      result = {(rotation[2][1] - rotation[1][2]) / s, s / 4.0,
+                (rotation[0][1] + rotation[1][0]) / s,
+                (rotation[0][2] + rotation[2][0]) / s};
+    } else if (m11 > m22) {
+      const double s = 2.0 * std::sqrt(1.0 + m11 - m00 - m22);
+      result = {(rotation[0][2] - rotation[2][0]) / s,
+                (rotation[0][1] + rotation[1][0]) / s, s / 4.0,
+                (rotation[1][2] + rotation[2][1]) / s};
+    } else {
+      const double s = 2.0 * std::sqrt(1.0 + m22 - m00 - m11);
+      result = {(rotation[1][0] - rotation[0][1]) / s,
+                (rotation[0][2] + rotation[2][0]) / s,
+                (rotation[1][2] + rotation[2][1]) / s, s / 4.0};
+    }
+    return result.normalized();
+  }
+
+  Matrix3 Quaternion::toRotationMatrix() const {
+    const double xx = x_ * x_;
+    const double yy = y_ * y_;
+    const double zz = z_ * z_;
+    const double xy = x_ * y_;
+    const double xz = x_ * z_;
+    const double yz = y_ * z_;
+    const double wx = w_ * x_;
+    const double wy = w_ * y_;
+    const double wz = w_ * z_;
+    return Matrix3(
+      1.0 - 2.0 * (yy + zz), 2.0 * (xy - wz), 2.0 * (xz + wy),
+      2.0 * (xy + wz), 1.0 - 2.0 * (xx + zz), 2.0 * (yz - wx),
+      2.0 * (xz - wy), 2.0 * (yz + wx), 1.0 - 2.0 * (xx + yy));
+  }
+
+  double Quaternion::norm() const {
+    return std::sqrt(dot(*this));
+  }
+
+  Quaternion Quaternion::normalized() const {
+    return *this * (1.0 / norm());
+  }
+
+  Quaternion Quaternion::product(const Quaternion& quaternion1) const {
+    const Quaternion& q = quaternion1;
+    return {w_ * q.w_ - x_ * q.x_ - y_ * q.y_ - z_ * q.z_,
+            w_ * q.x_ + x_ * q.w_ + y_ * q.z_ - z_ * q.y_,
+            w_ * q.y_ - x_ * q.z_ + y_ * q.w_ + z_ * q.x_,
+            w_ * q.z_ + x_ * q.y_ - y_ * q.x_ + z_ * q.w_};
+  }
+
+  Vector3 Quaternion::rotate(const Vector3& vector1) const {
+    // v + w * t + q_vec x t, with t = 2 * q_vec x v.
+    const double tx = 2.0 * (y_ * vector1.z() - z_ * vector1.y());
+    const double ty = 2.0 * (z_ * vector1.x() - x_ * vector1.z());
+    const double tz = 2.0 * (x_ * vector1.y() - y_ * vector1.x());
+    return Vector3(vector1.x() + w_ * tx + (y_ * tz - z_ * ty),
+                   vector1.y() + w_ * ty + (z_ * tx - x_ * tz),
+                   vector1.z() + w_ * tz + (x_ * ty - y_ * tx));
+  }
+
+  bool Quaternion::operator==(const Quaternion& quaternion1) const {
+    return Vector4(w_, x_, y_, z_) ==
+           Vector4(quaternion1.w_, quaternion1.x_, quaternion1.y_,
+                   quaternion1.z_);
+  }
+
+  bool Quaternion::operator!=(const Quaternion& quaternion1) const {
+    return !(*this == quaternion1);
+  }
+
+  Quaternion Quaternion::operator+(const Quaternion& quaternion1) const {
+    return {w_ + quaternion1.w_, x_ + quaternion1.x_, y_ + quaternion1.y_,
+            z_ + quaternion1.z_};
+  }
+
+  Quaternion Quaternion::operator-(const Quaternion& quaternion1) const {
+    return {w_ - quaternion1.w_, x_ - quaternion1.x_, y_ - quaternion1.y_,
+            z_ - quaternion1.z_};
+  }
+
+  Quaternion Quaternion::operator*(const Quaternion& quaternion1) const {
+    return product(quaternion1);
+  }
+
+  Quaternion Quaternion::operator*(const double scalar) const {
+    return {w_ * scalar, x_ * scalar, y_ * scalar, z_ * scalar};
+  }
+
+  Vector3 Quaternion::operator*(const Vector3& vector1) const {
+    return rotate(vector1);
+  }
+
+  Quaternion operator*(const double scalar, const Quaternion& quaternion1) {
+    return quaternion1 * scalar;
+  }
+
+  std::ostream& operator<<(std::ostream &ss, const Quaternion& quaternion1) {
+    ss << "(w: " << quaternion1.w_
+       << ", x: " << quaternion1.x_
+       << ", y: " << quaternion1.y_
+       << ", z: " << quaternion1.z_
+       << ")";
+    return ss;
+  }
+
+  constexpr Quaternion Quaternion::kIdentity = Quaternion(1.0, 0.0, 0.0, 0.0);
+
+  QuaternionIsometry::QuaternionIsometry(const Vector3& translation,
+                                         const Quaternion& rotation) :
+    translation_{translation}, rotation_{rotation} {}
+
+  QuaternionIsometry::QuaternionIsometry() {}
+
+  QuaternionIsometry::QuaternionIsometry(const Isometry& isometry) :
+    translation_{isometry.translation()},
+    rotation_{Quaternion::fromRotationMatrix(isometry.rotation())} {}
+
+  Isometry QuaternionIsometry::toIsometry() const {
+    return {translation_, rotation_.toRotationMatrix()};
+  }
+
+  const Vector3& QuaternionIsometry::translation() const {
+    return translation_;
+  }
+
+  const Quaternion& QuaternionIsometry::rotation() const {
+    return rotation_;
+  }
+
+  Matrix3 QuaternionIsometry::rotationMatrix() const {
+    return rotation_.toRotationMatrix();
+  }
+
+  Vector3 QuaternionIsometry::transform(const Vector3& vector1) const {
+    return rotation_.rotate(vector1) + translation_;
+  }
+
+  QuaternionIsometry QuaternionIsometry::inverse() const {
+    const Quaternion rotation = rotation_.conjugate();
+    return {Vector3::kZero - rotation.rotate(translation_), rotation};
+  }
+
+  QuaternionIsometry QuaternionIsometry::compose(
+      const QuaternionIsometry& isometry1) const {
+    return {transform(isometry1.translation_),
+            rotation_.product(isometry1.rotation_)};
+  }
+
+  QuaternionIsometry& QuaternionIsometry::normalize() {
+    rotation_ = rotation_.normalized();
+    return *this;
+  }
+
+  bool QuaternionIsometry::operator==(
+      const QuaternionIsometry& isometry1) const {
+    return translation_ == isometry1.translation_ &&
+           (rotation_ == isometry1.rotation_ ||
+            rotation_ == isometry1.rotation_ * -1.0);
+  }
+
+  bool QuaternionIsometry::operator!=(
+      const QuaternionIsometry& isometry1) const {
+    return !(*this == isometry1);
+  }
+
+  QuaternionIsometry QuaternionIsometry::operator*(
+      const QuaternionIsometry& isometry1) const {
+    return compose(isometry1);
+  }
+
+  Vector3 QuaternionIsometry::operator*(const Vector3& vector1) const {
+    return transform(vector1);
+  }
+
+  QuaternionIsometry& QuaternionIsometry::operator*=(
+      const QuaternionIsometry& isometry1) {
+    *this = compose(isometry1);
+    return *this;
+  }
+
+  std::ostream& operator<<(std::ostream &ss,
+                           const QuaternionIsometry& isometry1) {
+    ss << "[T: " << isometry1.translation_
+       << ", Q: " << isometry1.rotation_ << "]";
+    return ss;
+  }
+
+}  // namespace math
+}  // namespace ekumen
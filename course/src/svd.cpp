@@ -0,0 +1,306 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/svd.hpp>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  // Jacobi sweeps over the three off-diagonal pairs. Exact rotation angles
+  // converge quadratically, four sweeps reach double precision.
+  const int kJacobiSweeps = 4;
+  // Upper bound for the reference implementation.
+  const int kMaxReferenceSweeps = 32;
+  const double kTiny = std::numeric_limits<double>::min();
+  const double kEpsilon = std::numeric_limits<double>::epsilon();
+
+  void load(const Matrix3& matrix, double out[3][3]) {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        out[i][j] = matrix[i][j];
+      }
+    }
+  }
+
+  Matrix3 store(const double in[3][3]) {
+    return Matrix3(in[0][0], in[0][1], in[0][2],
+                   in[1][0], in[1][1], in[1][2],
+                   in[2][0], in[2][1], in[2][2]);
+  }
+
+  void setIdentity(double out[3][3]) {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        out[i][j] = (i == j) ? 1.0 : 0.0;
+      }
+    }
+  }
+
+  // Applies the plane rotation (c, s) to columns p and q of matrix.
+  void rotateColumns(double matrix[3][3], int p, int q, double c, double s) {
+    for (int k = 0; k < 3; ++k) {
+      const double kp = matrix[k][p];
+      const double kq = matrix[k][q];
+      matrix[k][p] = c * kp + s * kq;
+      matrix[k][q] = c * kq - s * kp;
+    }
+  }
+
+  // Applies the plane rotation (c, s) to rows p and q of matrix.
+  void rotateRows(double matrix[3][3], int p, int q, double c, double s) {
+    for (int k = 0; k < 3; ++k) {
+      const double pk = matrix[p][k];
+      const double qk = matrix[q][k];
+      matrix[p][k] = c * pk + s * qk;
+      matrix[q][k] = c * qk - s * pk;
+    }
+  }
+
+  // Annihilates symmetric[p][q] with a two-sided rotation, accumulated in v.
+  // The angle is kept within [-pi/4, pi/4] and selected without branches;
+  // (c, s) is the normalized half-angle vector of (|diff|, off).
+  void jacobiRotation(double symmetric[3][3], double v[3][3], int p, int q) {
+    const double diff = symmetric[p][p] - symmetric[q][q];
+    const double off = 2.0 * symmetric[p][q] * std::copysign(1.0, diff);
+    const double half = std::fabs(diff) + std::sqrt(diff * diff + off * off);
+    const double length = std::sqrt(half * half + off * off);
+    const bool rotate = length > kTiny;
+    const double inverse = 1.0 / (rotate ? length : 1.0);
+    const double c = rotate ? half * inverse : 1.0;
+    const double s = off * inverse;
+    // Only the p and q rows and columns change, with s[p][q] becoming zero.
+    const int r = 3 - p - q;
+    const double pp = symmetric[p][p];
+    const double qq = symmetric[q][q];
+    const double pq = symmetric[p][q];
+    const double rp = symmetric[r][p];
+    const double rq = symmetric[r][q];
+    symmetric[p][p] = c * c * pp + 2.0 * c * s * pq + s * s * qq;
+    symmetric[q][q] = s * s * pp - 2.0 * c * s * pq + c * c * qq;
+    symmetric[p][q] = symmetric[q][p] = 0.0;
+    symmetric[r][p] = symmetric[p][r] = c * rp + s * rq;
+    symmetric[r][q] = symmetric[q][r] = c * rq - s * rp;
+    rotateColumns(v, p, q, c, s);
+  }
+
+  // Swaps columns i and j of b and v when column j of b is longer, negating
+  // the new column j so that det(v) keeps its sign.
+  void conditionalSwap(double b[3][3], double v[3][3], double norms[3],
+                       int i, int j) {
+    const bool swap = norms[i] < norms[j];
+    for (int k = 0; k < 3; ++k) {
+      const double bi = b[k][i];
+      const double bj = b[k][j];
+      b[k][i] = swap ? bj : bi;
+      b[k][j] = swap ? -bi : bj;
+      const double vi = v[k][i];
+      const double vj = v[k][j];
+      v[k][i] = swap ? vj : vi;
+      v[k][j] = swap ? -vi : vj;
+    }
+    const double ni = norms[i];
+    norms[i] = swap ? norms[j] : ni;
+    norms[j] = swap ? ni : norms[j];
+  }
+
+  // Zeroes b[q][p] with a Givens rotation of rows p and q, accumulating its
+  // transpose in u so that u * b stays invariant.
+  void givensQR(double b[3][3], double u[3][3], int p, int q) {
+    const double pivot = b[p][p];
+    const double target = b[q][p];
+    const double radius = std::sqrt(pivot * pivot + target * target);
+    const bool rotate = radius > kTiny;
+    const double c = rotate ? pivot / radius : 1.0;
+    const double s = rotate ? target / radius : 0.0;
+    rotateRows(b, p, q, c, s);
+    rotateColumns(u, p, q, c, s);
+  }
+
+  double det(const double m[3][3]) {
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+           m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+           m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  }
+
+  void swapColumns(double matrix[3][3], int i, int j) {
+    for (int k = 0; k < 3; ++k) {
+      std::swap(matrix[k][i], matrix[k][j]);
+    }
+  }
+
+  void negateColumn(double matrix[3][3], int i) {
+    for (int k = 0; k < 3; ++k) {
+      matrix[k][i] = -matrix[k][i];
+    }
+  }
+
+}  // namespace
+
+  SVD3 svd(const Matrix3& matrix) {
+    double a[3][3];
+    load(matrix, a);
+
+    // Eigenvectors of a^T * a are the right singular vectors.
+    double symmetric[3][3];
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        symmetric[i][j] = a[0][i] * a[0][j] + a[1][i] * a[1][j] +
+                          a[2][i] * a[2][j];
+      }
+    }
+    double v[3][3];
+    setIdentity(v);
+    for (int sweep = 0; sweep < kJacobiSweeps; ++sweep) {
+      jacobiRotation(symmetric, v, 0, 1);
+      jacobiRotation(symmetric, v, 0, 2);
+      jacobiRotation(symmetric, v, 1, 2);
+    }
+
+    // b = a * v has orthogonal columns, sorted here by decreasing length.
+    double b[3][3];
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        b[i][j] = a[i][0] * v[0][j] + a[i][1] * v[1][j] + a[i][2] * v[2][j];
+      }
+    }
+    double norms[3];
+    for (int j = 0; j < 3; ++j) {
+      norms[j] = b[0][j] * b[0][j] + b[1][j] * b[1][j] + b[2][j] * b[2][j];
+    }
+    conditionalSwap(b, v, norms, 0, 1);
+    conditionalSwap(b, v, norms, 0, 2);
+    conditionalSwap(b, v, norms, 1, 2);
+
+    // QR of b leaves the singular values on the diagonal of b.
+    double u[3][3];
+    setIdentity(u);
+    givensQR(b, u, 0, 1);
+    givensQR(b, u, 0, 2);
+    givensQR(b, u, 1, 2);
+
+    return {store(u), Vector3(b[0][0], b[1][1], b[2][2]), store(v)};
+  }
+
+  void svd(const Matrix3* matrices, SVD3* results, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      results[i] = svd(matrices[i]);
+    }
+  }
+
+  SVD3 jacobiSvd(const Matrix3& matrix) {
+    double a[3][3];
+    load(matrix, a);
+    double v[3][3];
+    setIdentity(v);
+
+    for (int sweep = 0; sweep < kMaxReferenceSweeps; ++sweep) {
+      bool converged = true;
+      for (int p = 0; p < 2; ++p) {
+        for (int q = p + 1; q < 3; ++q) {
+          double alpha = 0.0;
+          double beta = 0.0;
+          double gamma = 0.0;
+          for (int k = 0; k < 3; ++k) {
+            alpha += a[k][p] * a[k][p];
+            beta += a[k][q] * a[k][q];
+            gamma += a[k][p] * a[k][q];
+          }
+          if (std::fabs(gamma) <= kEpsilon * std::sqrt(alpha * beta)) {
+            continue;
+          }
+          converged = false;
+          const double zeta = (beta - alpha) / (2.0 * gamma);
+          const double t = std::copysign(1.0, zeta) /
+                           (std::fabs(zeta) + std::sqrt(1.0 + zeta * zeta));
+          const double c = 1.0 / std::sqrt(1.0 + t * t);
+          rotateColumns(a, p, q, c, -c * t);
+          rotateColumns(v, p, q, c, -c * t);
+        }
+      }
+      if (converged) {
+        break;
+      }
+    }
+
+    double sigma[3];
+    for (int j = 0; j < 3; ++j) {
+      sigma[j] = std::sqrt(a[0][j] * a[0][j] + a[1][j] * a[1][j] +
+                           a[2][j] * a[2][j]);
+    }
+    for (int i = 0; i < 2; ++i) {
+      for (int j = i + 1; j < 3; ++j) {
+        if (sigma[i] < sigma[j]) {
+          std::swap(sigma[i], sigma[j]);
+          swapColumns(a, i, j);
+          swapColumns(v, i, j);
+        }
+      }
+    }
+
+    double u[3][3];
+    for (int j = 0; j < 3; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        u[k][j] = sigma[j] > kTiny ? a[k][j] / sigma[j] : 0.0;
+      }
+    }
+    if (sigma[2] <= kEpsilon * sigma[0]) {
+      u[0][2] = u[1][0] * u[2][1] - u[2][0] * u[1][1];
+      u[1][2] = u[2][0] * u[0][1] - u[0][0] * u[2][1];
+      u[2][2] = u[0][0] * u[1][1] - u[1][0] * u[0][1];
+    }
+    if (det(u) < 0.0) {
+      negateColumn(u, 2);
+      sigma[2] = -sigma[2];
+    }
+    if (det(v) < 0.0) {
+      negateColumn(v, 2);
+      sigma[2] = -sigma[2];
+    }
+    return {store(u), Vector3(sigma[0], sigma[1], sigma[2]), store(v)};
+  }
+
+  Matrix3 nearestRotation(const Matrix3& matrix) {
+    const SVD3 decomposition = svd(matrix);
+    return decomposition.u.product(decomposition.v.transpose());
+  }
+
+  Matrix3 fitRotation(const Vector3* source, const Vector3* target,
+                      std::size_t count) {
+    if (count == 0) {
+      throw std::invalid_argument("Cannot fit a rotation to no points");
+    }
+    Vector3 source_centroid;
+    Vector3 target_centroid;
+    for (std::size_t i = 0; i < count; ++i) {
+      source_centroid += source[i];
+      target_centroid += target[i];
+    }
+    source_centroid /= static_cast<double>(count);
+    target_centroid /= static_cast<double>(count);
+
+    Matrix3 covariance;
+    for (std::size_t i = 0; i < count; ++i) {
+      const Vector3 p = source[i] - source_centroid;
+      const Vector3 q = target[i] - target_centroid;
+      for (int j = 0; j < 3; ++j) {
+        covariance[j] += q * p[j];
+      }
+    }
+    const SVD3 decomposition = svd(covariance);
+    return decomposition.v.product(decomposition.u.transpose());
+  }
+
+}  // namespace math
+}  // namespace ekumen
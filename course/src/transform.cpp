@@ -0,0 +1,320 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/transform.hpp>
+
+#include <isometry/parallel.hpp>
+
+#include <functional>
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+  // Rotation, row major, and translation of the transform applied.
+  struct Kernel {
+    explicit Kernel(const Isometry& isometry) {
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          r[3 * i + j] = isometry.rotation()[i][j];
+        }
+        t[i] = isometry.translation()[i];
+      }
+    }
+
+    // Kernel of isometry.inverse(): R^T and -R^T * t.
+    static Kernel inverse(const Isometry& isometry) {
+      Kernel kernel(isometry);
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          kernel.r[3 * i + j] = isometry.rotation()[j][i];
+        }
+      }
+      for (int i = 0; i < 3; ++i) {
+        kernel.t[i] = -(kernel.r[3 * i] * isometry.translation().x() +
+                        kernel.r[3 * i + 1] * isometry.translation().y() +
+                        kernel.r[3 * i + 2] * isometry.translation().z());
+      }
+      return kernel;
+    }
+
+    double r[9];
+    double t[3];
+  };
+
+  void transformRange(const Kernel& k, const Vector3* points,
+                      Vector3* results, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      const double x = points[i].x();
+      const double y = points[i].y();
+      const double z = points[i].z();
+      results[i] = Vector3(k.r[0] * x + k.r[1] * y + k.r[2] * z + k.t[0],
+                           k.r[3] * x + k.r[4] * y + k.r[5] * z + k.t[1],
+                           k.r[6] * x + k.r[7] * y + k.r[8] * z + k.t[2]);
+    }
+  }
+
+  void transformRange(const Kernel& k, const char* points,
+                      std::size_t points_stride, char* results,
+                      std::size_t results_stride, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      const double* in =
+          reinterpret_cast<const double*>(points + i * points_stride);
+      double* out = reinterpret_cast<double*>(results + i * results_stride);
+      const double x = in[0];
+      const double y = in[1];
+      const double z = in[2];
+      out[0] = k.r[0] * x + k.r[1] * y + k.r[2] * z + k.t[0];
+      out[1] = k.r[3] * x + k.r[4] * y + k.r[5] * z + k.t[1];
+      out[2] = k.r[6] * x + k.r[7] * y + k.r[8] * z + k.t[2];
+    }
+  }
+
+  // The SoA kernels copy the coefficients into locals, so that the stores
+  // cannot clobber them, and take __restrict pointers, so that the compiler
+  // vectorizes them without runtime alias checks. GCC gives up on the loop
+  // when it needs more than 10 such checks, and six arrays need 12.
+  void transformDisjoint(const Kernel& k, const double* __restrict xs,
+                         const double* __restrict ys,
+                         const double* __restrict zs,
+                         double* __restrict out_xs, double* __restrict out_ys,
+                         double* __restrict out_zs, std::size_t size) {
+    const double r0 = k.r[0];
+    const double r1 = k.r[1];
+    const double r2 = k.r[2];
+    const double r3 = k.r[3];
+    const double r4 = k.r[4];
+    const double r5 = k.r[5];
+    const double r6 = k.r[6];
+    const double r7 = k.r[7];
+    const double r8 = k.r[8];
+    const double t0 = k.t[0];
+    const double t1 = k.t[1];
+    const double t2 = k.t[2];
+    for (std::size_t i = 0; i < size; ++i) {
+      const double x = xs[i];
+      const double y = ys[i];
+      const double z = zs[i];
+      out_xs[i] = r0 * x + r1 * y + r2 * z + t0;
+      out_ys[i] = r3 * x + r4 * y + r5 * z + t1;
+      out_zs[i] = r6 * x + r7 * y + r8 * z + t2;
+    }
+  }
+
+  // Each element is read before it is overwritten, so x, y and z only need
+  // to be distinct arrays.
+  void transformInPlace(const Kernel& k, double* __restrict xs,
+                        double* __restrict ys, double* __restrict zs,
+                        std::size_t size) {
+    const double r0 = k.r[0];
+    const double r1 = k.r[1];
+    const double r2 = k.r[2];
+    const double r3 = k.r[3];
+    const double r4 = k.r[4];
+    const double r5 = k.r[5];
+    const double r6 = k.r[6];
+    const double r7 = k.r[7];
+    const double r8 = k.r[8];
+    const double t0 = k.t[0];
+    const double t1 = k.t[1];
+    const double t2 = k.t[2];
+    for (std::size_t i = 0; i < size; ++i) {
+      const double x = xs[i];
+      const double y = ys[i];
+      const double z = zs[i];
+      xs[i] = r0 * x + r1 * y + r2 * z + t0;
+      ys[i] = r3 * x + r4 * y + r5 * z + t1;
+      zs[i] = r6 * x + r7 * y + r8 * z + t2;
+    }
+  }
+
+  // Any other overlap between the arrays, element by element.
+  void transformRange(const Kernel& k, const double* xs, const double* ys,
+                      const double* zs, double* out_xs, double* out_ys,
+                      double* out_zs, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      const double x = xs[i];
+      const double y = ys[i];
+      const double z = zs[i];
+      out_xs[i] = k.r[0] * x + k.r[1] * y + k.r[2] * z + k.t[0];
+      out_ys[i] = k.r[3] * x + k.r[4] * y + k.r[5] * z + k.t[1];
+      out_zs[i] = k.r[6] * x + k.r[7] * y + k.r[8] * z + k.t[2];
+    }
+  }
+
+  bool overlap(const double* a, const double* b, std::size_t size) {
+    const std::less<const double*> less;
+    return less(a, b + size) && less(b, a + size);
+  }
+
+  // Picks the SoA kernel for the way points and results share memory.
+  void transformRange(const Kernel& k, const SoAPoints<const double>& points,
+                      const SoAPoints<double>& results, std::size_t begin,
+                      std::size_t size) {
+    const double* in[3] = {points.x + begin, points.y + begin,
+                           points.z + begin};
+    double* out[3] = {results.x + begin, results.y + begin,
+                      results.z + begin};
+    bool outputs_disjoint = true;
+    bool in_place = true;
+    bool disjoint = true;
+    for (int i = 0; i < 3; ++i) {
+      in_place = in_place && in[i] == out[i];
+      for (int j = 0; j < 3; ++j) {
+        outputs_disjoint =
+            outputs_disjoint && (i == j || !overlap(out[i], out[j], size));
+        disjoint = disjoint && !overlap(in[i], out[j], size);
+      }
+    }
+    if (outputs_disjoint && in_place) {
+      transformInPlace(k, out[0], out[1], out[2], size);
+    } else if (outputs_disjoint && disjoint) {
+      transformDisjoint(k, in[0], in[1], in[2], out[0], out[1], out[2], size);
+    } else {
+      transformRange(k, in[0], in[1], in[2], out[0], out[1], out[2], size);
+    }
+  }
+
+  // Runs function(begin, size) over [0, count), on up to threads threads.
+  template <typename Function>
+  void run(std::size_t count, std::size_t threads,
+           const Function& function) {
+    const std::size_t blocks =
+        internal::parallelBlocks(count, threads, kMinParallelPoints);
+    if (blocks == 1) {
+      function(0, count);
+      return;
+    }
+    internal::forEachBlock(count, blocks, [&](std::size_t,
+                                              std::size_t begin,
+                                              std::size_t size) {
+      function(begin, size);
+    });
+  }
+
+  void checkCounts(std::size_t points, std::size_t results) {
+    if (points != results) {
+      throw std::invalid_argument("Point and result counts differ");
+    }
+  }
+
+  void apply(const Kernel& kernel, const Vector3* points, Vector3* results,
+             std::size_t count, std::size_t threads) {
+    run(count, threads, [&](std::size_t begin, std::size_t size) {
+      transformRange(kernel, points + begin, results + begin, size);
+    });
+  }
+
+  void apply(const Kernel& kernel, const StridedPoints<const double>& points,
+             const StridedPoints<double>& results, std::size_t threads) {
+    checkCounts(points.count, results.count);
+    const char* in = reinterpret_cast<const char*>(points.xyz);
+    char* out = reinterpret_cast<char*>(results.xyz);
+    run(points.count, threads, [&](std::size_t begin, std::size_t size) {
+      transformRange(kernel, in + begin * points.stride, points.stride,
+                     out + begin * results.stride, results.stride, size);
+    });
+  }
+
+  void apply(const Kernel& kernel, const SoAPoints<const double>& points,
+             const SoAPoints<double>& results, std::size_t threads) {
+    checkCounts(points.count, results.count);
+    run(points.count, threads, [&](std::size_t begin, std::size_t size) {
+      transformRange(kernel, points, results, begin, size);
+    });
+  }
+
+  StridedPoints<const double> asConst(const StridedPoints<double>& points) {
+    return {points.xyz, points.count, points.stride};
+  }
+
+  SoAPoints<const double> asConst(const SoAPoints<double>& points) {
+    return {points.x, points.y, points.z, points.count};
+  }
+
+}  // namespace
+
+  void transform(const Isometry& isometry, const Vector3* points,
+                 Vector3* results, const std::size_t count,
+                 const std::size_t threads) {
+    apply(Kernel(isometry), points, results, count, threads);
+  }
+
+  void transform(const Isometry& isometry,
+                 const StridedPoints<const double>& points,
+                 const StridedPoints<double>& results,
+                 const std::size_t threads) {
+    apply(Kernel(isometry), points, results, threads);
+  }
+
+  void transform(const Isometry& isometry,
+                 const SoAPoints<const double>& points,
+                 const SoAPoints<double>& results,
+                 const std::size_t threads) {
+    apply(Kernel(isometry), points, results, threads);
+  }
+
+  void transformInPlace(const Isometry& isometry, Vector3* points,
+                        const std::size_t count, const std::size_t threads) {
+    apply(Kernel(isometry), points, points, count, threads);
+  }
+
+  void transformInPlace(const Isometry& isometry,
+                        const StridedPoints<double>& points,
+                        const std::size_t threads) {
+    apply(Kernel(isometry), asConst(points), points, threads);
+  }
+
+  void transformInPlace(const Isometry& isometry,
+                        const SoAPoints<double>& points,
+                        const std::size_t threads) {
+    apply(Kernel(isometry), asConst(points), points, threads);
+  }
+
+  void inverseTransform(const Isometry& isometry, const Vector3* points,
+                        Vector3* results, const std::size_t count,
+                        const std::size_t threads) {
+    apply(Kernel::inverse(isometry), points, results, count, threads);
+  }
+
+  void inverseTransform(const Isometry& isometry,
+                        const StridedPoints<const double>& points,
+                        const StridedPoints<double>& results,
+                        const std::size_t threads) {
+    apply(Kernel::inverse(isometry), points, results, threads);
+  }
+
+  void inverseTransform(const Isometry& isometry,
+                        const SoAPoints<const double>& points,
+                        const SoAPoints<double>& results,
+                        const std::size_t threads) {
+    apply(Kernel::inverse(isometry), points, results, threads);
+  }
+
+  void inverseTransformInPlace(const Isometry& isometry, Vector3* points,
+                               const std::size_t count,
+                               const std::size_t threads) {
+    apply(Kernel::inverse(isometry), points, points, count, threads);
+  }
+
+  void inverseTransformInPlace(const Isometry& isometry,
+                               const StridedPoints<double>& points,
+                               const std::size_t threads) {
+    apply(Kernel::inverse(isometry), asConst(points), points, threads);
+  }
+
+  void inverseTransformInPlace(const Isometry& isometry,
+                               const SoAPoints<double>& points,
+                               const std::size_t threads) {
+    apply(Kernel::inverse(isometry), asConst(points), points, threads);
+  }
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,227 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jorge J. Perez, 2020
+ */
+// Copyright 2020, Blast545
+
+#include <isometry/transform_buffer.hpp>
+
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+  TransformBuffer::TransformBuffer(const std::size_t capacity,
+                                   const double retention) {
+    if (capacity == 0) {
+      throw std::invalid_argument("Buffer capacity must not be zero");
+    }
+    samples_.resize(capacity);
+    setRetention(retention);
+  }
+
+  void TransformBuffer::insert(const double stamp, const Isometry& isometry) {
+    insert({stamp, isometry});
+  }
+
+  void TransformBuffer::insert(const StampedIsometry& sample) {
+    if (size_ > 0 && !(sample.stamp > newest().stamp)) {
+      throw std::invalid_argument("Samples must be inserted in time order");
+    }
+    if (size_ == samples_.size()) {
+      head_ = head_ + 1 == samples_.size() ? 0 : head_ + 1;
+      --size_;
+    }
+    std::size_t tail = head_ + size_;
+    if (tail >= samples_.size()) {
+      tail -= samples_.size();
+    }
+    samples_[tail] = sample;
+    ++size_;
+    dropOlderThan(sample.stamp - retention_);
+  }
+
+  void TransformBuffer::clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  void TransformBuffer::setRetention(const double retention) {
+    if (!(retention > 0.0)) {
+      throw std::invalid_argument("Retention must be positive");
+    }
+    retention_ = retention;
+    if (size_ > 0) {
+      dropOlderThan(newest().stamp - retention_);
+    }
+  }
+
+  double TransformBuffer::retention() const {
+    return retention_;
+  }
+
+  std::size_t TransformBuffer::capacity() const {
+    return samples_.size();
+  }
+
+  std::size_t TransformBuffer::size() const {
+    return size_;
+  }
+
+  bool TransformBuffer::empty() const {
+    return size_ == 0;
+  }
+
+  const StampedIsometry& TransformBuffer::operator[](
+      const std::size_t i) const {
+    const std::size_t index = head_ + i;
+    return samples_[index < samples_.size() ? index :
+                                              index - samples_.size()];
+  }
+
+  const StampedIsometry& TransformBuffer::oldest() const {
+    if (size_ == 0) {
+      throw std::out_of_range("Transform buffer is empty");
+    }
+    return (*this)[0];
+  }
+
+  const StampedIsometry& TransformBuffer::newest() const {
+    if (size_ == 0) {
+      throw std::out_of_range("Transform buffer is empty");
+    }
+    return (*this)[size_ - 1];
+  }
+
+  std::size_t TransformBuffer::find(const double stamp) const {
+    if (size_ == 0 || stamp < (*this)[0].stamp) {
+      throw std::out_of_range("Stamp is before the oldest sample");
+    }
+    // Invariant: (*this)[low].stamp <= stamp < (*this)[high].stamp.
+    std::size_t low = 0;
+    std::size_t high = size_;
+    while (high - low > 1) {
+      const std::size_t middle = low + (high - low) / 2;
+      if ((*this)[middle].stamp <= stamp) {
+        low = middle;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  Isometry TransformBuffer::lookup(const double stamp,
+                                   const Interpolation mode) const {
+    const std::size_t i = find(stamp);
+    const StampedIsometry& before = (*this)[i];
+    if (before.stamp == stamp) {
+      return before.isometry;
+    }
+    if (i + 1 == size_) {
+      throw std::out_of_range("Stamp is after the newest sample");
+    }
+    const StampedIsometry& after = (*this)[i + 1];
+    return interpolate(before.isometry, after.isometry,
+                       (stamp - before.stamp) / (after.stamp - before.stamp),
+                       mode);
+  }
+
+  template <typename Function>
+  void TransformBuffer::walk(const double* stamps, const std::size_t count,
+                             const Interpolation mode,
+                             Function function) const {
+    if (count == 0) {
+      return;
+    }
+    std::size_t i = find(stamps[0]);
+    // Interpolator between samples i and i + 1, built on first use.
+    IsometryInterpolator interpolator(Isometry::kIdentity,
+                                      Isometry::kIdentity, mode);
+    bool stale = true;
+    for (std::size_t k = 0; k < count; ++k) {
+      const double stamp = stamps[k];
+      if (k > 0 && stamp < stamps[k - 1]) {
+        throw std::invalid_argument("Stamps must be sorted");
+      }
+      while (i + 1 < size_ && (*this)[i + 1].stamp <= stamp) {
+        ++i;
+        stale = true;
+      }
+      const StampedIsometry& before = (*this)[i];
+      if (before.stamp == stamp) {
+        function(k, before.isometry);
+        continue;
+      }
+      if (i + 1 == size_) {
+        throw std::out_of_range("Stamp is after the newest sample");
+      }
+      const StampedIsometry& after = (*this)[i + 1];
+      if (stale) {
+        interpolator = IsometryInterpolator(before.isometry, after.isometry,
+                                            mode);
+        stale = false;
+      }
+      function(k, interpolator.evaluate((stamp - before.stamp) /
+                                        (after.stamp - before.stamp)));
+    }
+  }
+
+  void TransformBuffer::lookup(const double* stamps, Isometry* results,
+                               const std::size_t count,
+                               const Interpolation mode) const {
+    walk(stamps, count, mode, [results](const std::size_t i,
+                                        const Isometry& pose) {
+      results[i] = pose;
+    });
+  }
+
+  void TransformBuffer::transform(const double* stamps, const Vector3* points,
+                                  Vector3* results, const std::size_t count,
+                                  const Interpolation mode) const {
+    walk(stamps, count, mode, [points, results](const std::size_t i,
+                                                const Isometry& pose) {
+      results[i] = pose.transform(points[i]);
+    });
+  }
+
+  Twist TransformBuffer::velocity(const double baseline) const {
+    if (size_ < 2) {
+      throw std::out_of_range("Velocity needs two samples");
+    }
+    const StampedIsometry& last = (*this)[size_ - 1];
+    const double stamp = last.stamp - baseline;
+    std::size_t i = stamp < (*this)[0].stamp ? 0 : find(stamp);
+    if (i + 1 == size_) {
+      --i;
+    }
+    const StampedIsometry& first = (*this)[i];
+    return logSE3(first.isometry.inverse() * last.isometry) *
+           (1.0 / (last.stamp - first.stamp));
+  }
+
+  Isometry TransformBuffer::extrapolate(const double stamp,
+                                        const double baseline) const {
+    const StampedIsometry& last = newest();
+    if (stamp < last.stamp) {
+      throw std::out_of_range("Stamp is before the newest sample");
+    }
+    return math::extrapolate(last, velocity(baseline), stamp);
+  }
+
+  void TransformBuffer::dropOlderThan(const double stamp) {
+    while (size_ > 1 && (*this)[0].stamp < stamp) {
+      head_ = head_ + 1 == samples_.size() ? 0 : head_ + 1;
+      --size_;
+    }
+  }
+
+  Isometry extrapolate(const StampedIsometry& sample, const Twist& velocity,
+                       const double stamp) {
+    return sample.isometry * expSE3(velocity * (stamp - sample.stamp));
+  }
+
+}  // namespace math
+}  // namespace ekumen
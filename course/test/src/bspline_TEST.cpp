@@ -0,0 +1,104 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <isometry/bspline.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(BSplineTest, BSplineFullTests) {
+  const Twist twist{Vector3(1., 0.5, -0.2), Vector3(0.1, -0.3, 0.2)};
+  const double kInterval{0.1};
+  std::vector<Isometry> controls;
+  for (int k = 0; k < 8; ++k) {
+    controls.push_back(expSE3(twist * k));
+  }
+  EXPECT_THROW(CubicBSplineTrajectory(controls.data(), 3, 0., kInterval),
+               std::invalid_argument);
+  EXPECT_THROW(CubicBSplineTrajectory(controls.data(), 8, 0., 0.),
+               std::invalid_argument);
+
+  const CubicBSplineTrajectory spline(controls.data(), controls.size(), 2.,
+                                      kInterval);
+  EXPECT_EQ(spline.segments(), 5u);
+  EXPECT_DOUBLE_EQ(spline.startTime(), 2.);
+  EXPECT_DOUBLE_EQ(spline.endTime(), 2.5);
+  EXPECT_THROW(spline.evaluate(1.99), std::out_of_range);
+  EXPECT_THROW(spline.evaluate(2.51), std::out_of_range);
+
+  // Equally spaced controls along a constant twist: the cumulative basis
+  // adds up to 1 + u, so the spline follows the twist exactly.
+  for (const double time : {2., 2.03, 2.1, 2.25, 2.4999, 2.5}) {
+    Twist velocity;
+    const Isometry pose{spline.evaluate(time, &velocity)};
+    EXPECT_EQ(pose, expSE3(twist * ((time - 2.) / kInterval + 1.)));
+    EXPECT_EQ(velocity, twist * (1. / kInterval));
+    EXPECT_EQ(spline.evaluate(time), pose);
+  }
+
+  // Generic controls: continuous across knots, velocity matches finite
+  // differences.
+  std::vector<Isometry> random_controls;
+  for (int k = 0; k < 6; ++k) {
+    random_controls.push_back(
+        Isometry::fromTranslation({0.3 * k, 0.1 * k * k, -0.2 * k}) *
+        Isometry::fromEulerAngles(0.2 * k, -0.1 * k, 0.05 * k * k));
+  }
+  const CubicBSplineTrajectory curve(random_controls.data(),
+                                     random_controls.size(), 0., 1.);
+  EXPECT_EQ(curve.evaluate(1. - 1e-9), curve.evaluate(1.));
+  EXPECT_EQ(curve.evaluate(2. - 1e-9), curve.evaluate(2. + 1e-9));
+  const double kStep{1e-6};
+  for (const double time : {0.1, 0.5, 1.3, 2.7}) {
+    Twist velocity;
+    const Isometry pose{curve.evaluate(time, &velocity)};
+    const Twist difference{
+        logSE3(pose.inverse() * curve.evaluate(time + kStep)) *
+        (1. / kStep)};
+    const Twist error{difference - velocity};
+    EXPECT_NEAR(error.linear.norm() + error.angular.norm(), 0., 1e-5);
+  }
+
+  // Batched evaluation of sorted times matches the single one.
+  std::vector<double> times;
+  for (int i = 0; i <= 60; ++i) {
+    times.push_back(i / 20.);
+  }
+  std::vector<Isometry> poses(times.size());
+  std::vector<Twist> velocities(times.size());
+  curve.evaluate(times.data(), poses.data(), times.size(), velocities.data());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    Twist velocity;
+    EXPECT_EQ(poses[i], curve.evaluate(times[i], &velocity));
+    EXPECT_EQ(velocities[i], velocity);
+  }
+  curve.evaluate(times.data() + 10, poses.data(), 20);
+  EXPECT_EQ(poses[0], curve.evaluate(times[10]));
+  std::swap(times[3], times[4]);
+  EXPECT_THROW(curve.evaluate(times.data(), poses.data(), times.size()),
+               std::invalid_argument);
+  times.push_back(3.5);
+  EXPECT_THROW(curve.evaluate(times.data() + 10, poses.data(), 52),
+               std::out_of_range);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,100 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <list>
+#include <vector>
+
+#include <isometry/compose.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+testing::AssertionResult areAlmostEqual(const Isometry &obj1,
+                                        const Isometry &obj2,
+                                        const double tolerance) {
+  for (int i = 0; i < 3; ++i) {
+    bool equal = std::abs(obj1.translation()[i] - obj2.translation()[i]) <=
+                 tolerance;
+    for (int j = 0; j < 3; ++j) {
+      equal = equal && std::abs(obj1.rotation()[i][j] -
+                                obj2.rotation()[i][j]) <= tolerance;
+    }
+    if (!equal) {
+      return testing::AssertionFailure() << obj1 << " != " << obj2;
+    }
+  }
+  return testing::AssertionSuccess();
+}
+
+// A wheel odometry like chain of small steps.
+std::vector<Isometry> makeChain(const std::size_t count) {
+  std::vector<Isometry> chain;
+  for (std::size_t i = 0; i < count; ++i) {
+    const double phase = static_cast<double>(i);
+    chain.emplace_back(
+        Vector3{0.01, 0.002 * std::sin(phase), 0.001},
+        Isometry::fromEulerAngles(0.001 * std::cos(phase), 0.002,
+                                  0.003 * std::sin(0.1 * phase))
+            .rotation());
+  }
+  return chain;
+}
+
+GTEST_TEST(ComposeTest, ComposeFullTests) {
+  const double kTolerance{1e-9};
+  const std::vector<Isometry> chain{makeChain(3 * kMinParallelChain + 17)};
+  Isometry sequential{Isometry::kIdentity};
+  std::vector<Isometry> expected;
+  for (const Isometry &step : chain) {
+    sequential *= step;
+    expected.push_back(sequential);
+  }
+
+  EXPECT_EQ(composeRange(chain.begin(), chain.begin()), Isometry::kIdentity);
+  EXPECT_EQ(composeRange(chain.begin(), chain.begin() + 1), chain[0]);
+  EXPECT_TRUE(areAlmostEqual(composeRange(chain.begin(), chain.begin() + 3),
+                             chain[0] * chain[1] * chain[2], kTolerance));
+  EXPECT_TRUE(areAlmostEqual(composeRange(chain.begin(), chain.end()),
+                             sequential, kTolerance));
+  for (std::size_t threads : {2u, 3u, 8u}) {
+    EXPECT_TRUE(areAlmostEqual(
+        composeRange(chain.begin(), chain.end(), threads), sequential,
+        kTolerance));
+  }
+  // Forward iterators work too.
+  const std::list<Isometry> list(chain.begin(), chain.begin() + 100);
+  EXPECT_TRUE(areAlmostEqual(composeRange(list.begin(), list.end()),
+                             expected[99], kTolerance));
+
+  for (std::size_t threads : {1u, 3u}) {
+    std::vector<Isometry> prefix(chain.size());
+    EXPECT_EQ(composePrefix(chain.begin(), chain.end(), prefix.begin(),
+                            threads),
+              prefix.end());
+    for (std::size_t i = 0; i < chain.size(); i += 97) {
+      EXPECT_TRUE(areAlmostEqual(prefix[i], expected[i], kTolerance));
+    }
+    EXPECT_TRUE(areAlmostEqual(prefix.back(), sequential, kTolerance));
+  }
+  std::vector<Isometry> empty;
+  EXPECT_EQ(composePrefix(chain.begin(), chain.begin(), empty.begin()),
+            empty.begin());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <isometry/decimation.hpp>
+#include <isometry/lie.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+// Largest translation and rotation errors of looking the samples up in a
+// buffer holding only the kept ones.
+void lookupErrors(const std::vector<StampedIsometry> &samples,
+                  const std::vector<std::size_t> &kept,
+                  double *translation_error, double *rotation_error) {
+  TransformBuffer buffer(kept.size());
+  for (const std::size_t i : kept) {
+    buffer.insert(samples[i]);
+  }
+  *translation_error = 0.;
+  *rotation_error = 0.;
+  for (const StampedIsometry &sample : samples) {
+    const Isometry pose{buffer.lookup(sample.stamp)};
+    *translation_error = std::max(
+        *translation_error,
+        (pose.translation() - sample.isometry.translation()).norm());
+    *rotation_error = std::max(
+        *rotation_error,
+        logSO3(pose.rotation().transpose().product(
+                   sample.isometry.rotation()))
+            .norm());
+  }
+}
+
+GTEST_TEST(DecimationTest, DecimationFullTests) {
+  std::vector<StampedIsometry> samples;
+  EXPECT_TRUE(decimate(samples.data(), 0, 0.1, 0.1).empty());
+  samples.push_back({0., Isometry::kIdentity});
+  EXPECT_EQ(decimate(samples.data(), 1, 0.1, 0.1),
+            std::vector<std::size_t>({0}));
+  EXPECT_THROW(decimate(samples.data(), 1, -0.1, 0.1),
+               std::invalid_argument);
+
+  // Constant velocity along a line while turning at a constant rate is
+  // exactly what the interpolation reproduces.
+  samples.clear();
+  for (int i = 0; i < 1000; ++i) {
+    const double stamp{1e-3 * i};
+    samples.push_back({stamp, Isometry::fromTranslation({stamp, 0., 0.}) *
+                                  Isometry::rotateAround({1., 2., 3.},
+                                                         2. * stamp)});
+  }
+  EXPECT_EQ(decimate(samples.data(), samples.size(), 1e-6, 1e-6),
+            std::vector<std::size_t>({0, 999}));
+  samples[500].stamp = samples[499].stamp;
+  EXPECT_THROW(decimate(samples.data(), samples.size(), 0.1, 0.1),
+               std::invalid_argument);
+
+  // A turn at the corner of an L is the only keyframe needed.
+  samples.clear();
+  for (int i = 0; i <= 200; ++i) {
+    const double x{i <= 100 ? i : 100.};
+    const double y{i <= 100 ? 0. : i - 100.};
+    const double yaw{i <= 100 ? 0. : M_PI / 2.};
+    samples.push_back({static_cast<double>(i),
+                       Isometry::fromTranslation({x, y, 0.}) *
+                           Isometry::rotateAround(Vector3::kUnitZ, yaw)});
+  }
+  EXPECT_EQ(decimate(samples.data(), samples.size(), 0.01, 10.),
+            std::vector<std::size_t>({0, 100, 200}));
+  // Only rotation matters: the yaw steps between samples 100 and 101.
+  EXPECT_EQ(decimate(samples.data(), samples.size(), 1e3, 0.01),
+            std::vector<std::size_t>({0, 100, 101, 200}));
+
+  // A wandering trajectory stays within both tolerances.
+  samples.clear();
+  for (int i = 0; i < 5000; ++i) {
+    const double stamp{1e-3 * i};
+    samples.push_back(
+        {stamp, Isometry::fromTranslation({std::sin(3. * stamp),
+                                           std::cos(2. * stamp), stamp}) *
+                    Isometry::fromEulerAngles(std::sin(stamp), 0.5 * stamp,
+                                              std::cos(5. * stamp))});
+  }
+  for (const double tolerance : {1e-2, 1e-3, 1e-4}) {
+    const std::vector<std::size_t> kept{
+        decimate(samples.data(), samples.size(), tolerance, tolerance)};
+    EXPECT_LT(kept.size(), samples.size() / 4);
+    EXPECT_EQ(kept.front(), 0u);
+    EXPECT_EQ(kept.back(), samples.size() - 1);
+    double translation_error;
+    double rotation_error;
+    lookupErrors(samples, kept, &translation_error, &rotation_error);
+    EXPECT_LE(translation_error, tolerance * (1. + 1e-9));
+    EXPECT_LE(rotation_error, tolerance * (1. + 1e-6));
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,89 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <sstream>
+
+#include <isometry/dual_quaternion.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(DualQuaternionTest, DualQuaternionFullTests) {
+  const double kTolerance{1e-12};
+  const Isometry i1{Vector3{1., 2., 3.},
+                    Isometry::fromEulerAngles(0.3, -0.2, 1.1).rotation()};
+  const Isometry i2{Vector3{-1., 0.5, 2.},
+                    Isometry::fromEulerAngles(-1., 0.4, 2.).rotation()};
+  const DualQuaternion q1{i1};
+  const DualQuaternion q2{i2};
+  const Vector3 p{0.5, -4., 2.};
+
+  EXPECT_EQ(DualQuaternion().toIsometry(), Isometry::kIdentity);
+  EXPECT_EQ(q1.toIsometry(), i1);
+  EXPECT_EQ(q1.translation(), i1.translation());
+  EXPECT_EQ(q1.toQuaternionIsometry(), QuaternionIsometry(i1));
+  EXPECT_EQ(DualQuaternion(QuaternionIsometry(i1)), q1);
+  EXPECT_NEAR(q1.real().dot(q1.dual()), 0., kTolerance);
+  EXPECT_EQ(q1 * p, i1 * p);
+  EXPECT_EQ((q1 * q2).toIsometry(), i1 * i2);
+  EXPECT_EQ(q1.compose(q2) * p, i1 * (i2 * p));
+  EXPECT_EQ(q1.conjugate().toIsometry(), i1.inverse());
+  EXPECT_EQ(q1 * q1.conjugate(), DualQuaternion());
+  EXPECT_EQ(q1 * -1., q1);
+  EXPECT_EQ(-1. * q1, q1);
+  EXPECT_NE(q1, q2);
+  EXPECT_EQ((q1 * 2.5).normalized(), q1);
+  EXPECT_EQ((q1 + q1).normalized(), q1);
+
+  // Blending.
+  const double halves[]{0.5, 0.5};
+  const DualQuaternion same[]{q1, q1 * -1.};
+  EXPECT_EQ(DualQuaternion::blend(same, halves, 2), q1);
+  EXPECT_EQ(DualQuaternion::blend(&q2, halves, 1), q2);
+  const DualQuaternion translations[]{
+      DualQuaternion(Isometry::fromTranslation(Vector3{2., 0., 0.})),
+      DualQuaternion(Isometry::fromTranslation(Vector3{0., 4., -2.}))};
+  EXPECT_EQ(DualQuaternion::blend(translations, halves, 2).translation(),
+            Vector3(1., 2., -1.));
+  const DualQuaternion rotations[]{
+      DualQuaternion(Isometry::rotateAround(Vector3::kUnitZ, 0.2)),
+      DualQuaternion(Isometry::rotateAround(Vector3::kUnitZ, 1.))};
+  EXPECT_EQ(DualQuaternion::blend(rotations, halves, 2).toIsometry(),
+            Isometry::rotateAround(Vector3::kUnitZ, 0.6));
+  // Any blend is rigid.
+  const DualQuaternion poses[]{q1, q2, DualQuaternion(translations[1])};
+  const double weights[]{0.2, 0.5, 0.3};
+  const DualQuaternion blended{DualQuaternion::blend(poses, weights, 3)};
+  EXPECT_NEAR(blended.real().norm(), 1., kTolerance);
+  EXPECT_NEAR(blended.real().dot(blended.dual()), 0., kTolerance);
+  const Matrix3 rotation{blended.toIsometry().rotation()};
+  EXPECT_EQ(rotation.product(rotation.transpose()), Matrix3::kIdentity);
+  EXPECT_THROW(DualQuaternion::blend(poses, weights, 0),
+               std::invalid_argument);
+  const double cancel[]{1., -1.};
+  EXPECT_THROW(DualQuaternion::blend(same, cancel, 2),
+               std::invalid_argument);
+
+  std::stringstream ss;
+  ss << DualQuaternion();
+  EXPECT_EQ(ss.str(),
+            "[R: (w: 1, x: 0, y: 0, z: 0), D: (w: 0, x: 0, y: 0, z: 0)]");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,206 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include <isometry/frame_tree.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(FrameTreeTest, FrameTreeFullTests) {
+  // world -> base -> arm -> hand
+  //               -> lidar
+  //       -> dock
+  const Isometry world_T_base{Isometry::fromTranslation({1., 2., 0.}) *
+                              Isometry::rotateAround(Vector3::kUnitZ, 0.5)};
+  const Isometry base_T_arm{Isometry::fromTranslation({0.2, 0., 0.4}) *
+                            Isometry::rotateAround(Vector3::kUnitY, -0.3)};
+  const Isometry arm_T_hand{Isometry::fromTranslation({0.5, 0., 0.}) *
+                            Isometry::rotateAround({1., 1., 0.}, 0.7)};
+  const Isometry base_T_lidar{Isometry::fromTranslation({0., 0., 0.8}) *
+                              Isometry::rotateAround(Vector3::kUnitX, M_PI)};
+  const Isometry world_T_dock{Isometry::fromTranslation({5., -1., 0.})};
+
+  FrameTree tree("world", 8);
+  tree.addFrame("base", "world", world_T_base);
+  tree.addFrame("arm", "base", base_T_arm);
+  tree.addFrame("hand", "arm", arm_T_hand);
+  tree.addFrame("lidar", "base", base_T_lidar);
+  tree.addFrame("dock", "world", world_T_dock);
+
+  EXPECT_EQ(tree.root(), "world");
+  EXPECT_EQ(tree.size(), 6u);
+  EXPECT_TRUE(tree.contains("hand"));
+  EXPECT_FALSE(tree.contains("gripper"));
+  EXPECT_EQ(tree.parent("hand"), "arm");
+  EXPECT_EQ(tree.transform("lidar"), base_T_lidar);
+
+  EXPECT_EQ(tree.lookup("hand", "hand"), Isometry::kIdentity);
+  EXPECT_EQ(tree.lookup("world", "hand"),
+            world_T_base * base_T_arm * arm_T_hand);
+  EXPECT_EQ(tree.lookup("hand", "world"),
+            (world_T_base * base_T_arm * arm_T_hand).inverse());
+  EXPECT_EQ(tree.lookup("lidar", "hand"),
+            base_T_lidar.inverse() * base_T_arm * arm_T_hand);
+  EXPECT_EQ(tree.lookup("dock", "lidar"),
+            world_T_dock.inverse() * world_T_base * base_T_lidar);
+  EXPECT_EQ(tree.lookup("hand", "lidar") * tree.lookup("lidar", "hand"),
+            Isometry::kIdentity);
+
+  const Isometry moved_arm{Isometry::fromTranslation({0.2, 0.1, 0.4})};
+  tree.setTransform("arm", moved_arm);
+  EXPECT_EQ(tree.lookup("lidar", "hand"),
+            base_T_lidar.inverse() * moved_arm * arm_T_hand);
+
+  EXPECT_THROW(tree.addFrame("arm", "world", world_T_base),
+               std::invalid_argument);
+  EXPECT_THROW(tree.addFrame("gripper", "wrist", world_T_base),
+               std::out_of_range);
+  EXPECT_THROW(tree.setTransform("world", world_T_base),
+               std::invalid_argument);
+  EXPECT_THROW(tree.setTransform("wrist", world_T_base), std::out_of_range);
+  EXPECT_THROW(tree.parent("world"), std::out_of_range);
+  EXPECT_THROW(tree.transform("world"), std::out_of_range);
+  EXPECT_THROW(tree.lookup("world", "wrist"), std::out_of_range);
+}
+
+GTEST_TEST(FrameTreeTest, CacheFullTests) {
+  const Isometry world_T_base{Isometry::fromTranslation({1., 2., 0.})};
+  const Isometry base_T_arm{Isometry::rotateAround(Vector3::kUnitY, -0.3)};
+  const Isometry world_T_dock{Isometry::fromTranslation({5., -1., 0.})};
+  FrameTree tree("world");
+  tree.addFrame("base", "world", world_T_base);
+  tree.addFrame("arm", "base", base_T_arm);
+  tree.addFrame("dock", "world", world_T_dock);
+  EXPECT_EQ(tree.cacheHitRate(), 0.);
+
+  // The reversed pair shares the entry.
+  const Isometry dock_T_arm{world_T_dock.inverse() * world_T_base *
+                            base_T_arm};
+  EXPECT_EQ(tree.cachedLookup("dock", "arm"), dock_T_arm);
+  EXPECT_EQ(tree.cachedLookup("dock", "arm"), dock_T_arm);
+  EXPECT_EQ(tree.cachedLookup("arm", "dock"), dock_T_arm.inverse());
+  EXPECT_EQ(tree.cachedLookup("arm", "arm"), Isometry::kIdentity);
+  EXPECT_EQ(tree.cacheHits(), 2u);
+  EXPECT_EQ(tree.cacheMisses(), 1u);
+  EXPECT_DOUBLE_EQ(tree.cacheHitRate(), 2. / 3.);
+
+  // lookup() bypasses the cache.
+  EXPECT_EQ(tree.lookup("dock", "arm"), dock_T_arm);
+  EXPECT_EQ(tree.cacheHits() + tree.cacheMisses(), 3u);
+
+  // Updating an edge off the path keeps the entry.
+  tree.addFrame("lidar", "base", world_T_dock);
+  tree.setTransform("lidar", world_T_base);
+  EXPECT_EQ(tree.cachedLookup("dock", "arm"), dock_T_arm);
+  EXPECT_EQ(tree.cacheHits(), 3u);
+
+  // Updating an edge on it recomputes it, also for the reversed pair.
+  const Isometry moved_base{Isometry::fromTranslation({1., 3., 0.})};
+  tree.setTransform("base", moved_base);
+  const Isometry moved{world_T_dock.inverse() * moved_base * base_T_arm};
+  EXPECT_EQ(tree.cachedLookup("arm", "dock"), moved.inverse());
+  EXPECT_EQ(tree.cachedLookup("dock", "arm"), moved);
+  EXPECT_EQ(tree.cacheMisses(), 2u);
+  EXPECT_EQ(tree.cacheHits(), 4u);
+
+  tree.resetCacheCounters();
+  EXPECT_EQ(tree.cacheHits(), 0u);
+  EXPECT_EQ(tree.cacheMisses(), 0u);
+  tree.clearCache();
+  EXPECT_EQ(tree.cachedLookup("dock", "arm"), moved);
+  EXPECT_EQ(tree.cacheMisses(), 1u);
+
+  // With a single slot, pairs evict each other instead of growing it.
+  FrameTree small("world", 1);
+  small.addFrame("base", "world", world_T_base);
+  small.addFrame("dock", "world", world_T_dock);
+  EXPECT_EQ(small.cachedLookup("world", "base"), world_T_base);
+  EXPECT_EQ(small.cachedLookup("world", "dock"), world_T_dock);
+  EXPECT_EQ(small.cachedLookup("base", "world"), world_T_base.inverse());
+  EXPECT_EQ(small.cacheMisses(), 3u);
+  EXPECT_EQ(small.cachedLookup("world", "base"), world_T_base);
+  EXPECT_EQ(small.cacheHits(), 1u);
+}
+
+GTEST_TEST(FrameTreeTest, FrameIdFullTests) {
+  const Isometry world_T_base{Isometry::fromTranslation({1., 2., 0.})};
+  const Isometry base_T_arm{Isometry::rotateAround(Vector3::kUnitY, -0.3)};
+  FrameTree tree("world");
+  const FrameId world{tree.id("world")};
+  const FrameId base{tree.addFrame("base", world, world_T_base)};
+  const FrameId arm{tree.addFrame("arm", "base", base_T_arm)};
+
+  EXPECT_TRUE(base.valid());
+  EXPECT_FALSE(FrameId().valid());
+  EXPECT_EQ(tree.id("arm"), arm);
+  EXPECT_NE(arm, base);
+  EXPECT_EQ(tree.name(arm), "arm");
+  EXPECT_EQ(tree.parent(arm), base);
+  EXPECT_EQ(tree.transform(arm), base_T_arm);
+
+  // Both layers see the same frames and share the cache.
+  EXPECT_EQ(tree.lookup(world, arm), world_T_base * base_T_arm);
+  EXPECT_EQ(tree.lookup("world", "arm"), tree.lookup(world, arm));
+  EXPECT_EQ(tree.cachedLookup(world, arm), world_T_base * base_T_arm);
+  EXPECT_EQ(tree.cachedLookup("world", "arm"), tree.cachedLookup(world, arm));
+  EXPECT_EQ(tree.cacheMisses(), 1u);
+  EXPECT_EQ(tree.cacheHits(), 2u);
+  EXPECT_EQ(tree.lookup(arm, arm), Isometry::kIdentity);
+
+  tree.setTransform(base, Isometry::kIdentity);
+  EXPECT_EQ(tree.lookup(world, arm), base_T_arm);
+  EXPECT_EQ(tree.lookup("arm", "world"), base_T_arm.inverse());
+
+  EXPECT_THROW(tree.id("wrist"), std::out_of_range);
+  EXPECT_THROW(tree.lookup(world, FrameId()), std::out_of_range);
+  EXPECT_THROW(tree.name(FrameId()), std::out_of_range);
+  EXPECT_THROW(tree.parent(world), std::out_of_range);
+  EXPECT_THROW(tree.setTransform(world, world_T_base),
+               std::invalid_argument);
+  EXPECT_THROW(tree.addFrame("base", arm, world_T_base),
+               std::invalid_argument);
+  // Handles of another tree are rejected, even when in range there.
+  FrameTree other("world");
+  const FrameId other_base{other.addFrame("base", "world", world_T_base)};
+  other.addFrame("arm", "base", base_T_arm);
+  EXPECT_NE(other_base, base);
+  EXPECT_EQ(other.id("base"), other_base);
+  EXPECT_THROW(other.lookup(world, arm), std::out_of_range);
+  EXPECT_THROW(other.name(base), std::out_of_range);
+  EXPECT_THROW(tree.setTransform(other_base, world_T_base),
+               std::out_of_range);
+
+  // Copies diverge from the original, so they do not share handles.
+  FrameTree copy(tree);
+  const FrameId a{tree.addFrame("a", world, world_T_base)};
+  const FrameId b{copy.addFrame("b", copy.id("world"), base_T_arm)};
+  EXPECT_EQ(a.index(), b.index());
+  EXPECT_THROW(copy.name(a), std::out_of_range);
+  EXPECT_THROW(copy.lookup(copy.id("world"), a), std::out_of_range);
+  EXPECT_THROW(tree.name(b), std::out_of_range);
+  EXPECT_THROW(copy.name(arm), std::out_of_range);
+  EXPECT_EQ(copy.name(copy.id("arm")), "arm");
+  other = tree;
+  EXPECT_THROW(other.name(a), std::out_of_range);
+  EXPECT_EQ(other.name(other.id("a")), "a");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <isometry/interpolation.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+// Angle of the rotation taking obj1 to obj2.
+double angleBetween(const Isometry &obj1, const Isometry &obj2) {
+  return logSO3(obj1.rotation().transpose().product(obj2.rotation())).norm();
+}
+
+GTEST_TEST(InterpolationTest, InterpolationFullTests) {
+  const Isometry start{Isometry::fromTranslation({1., 2., 3.}) *
+                       Isometry::rotateAround({1., 1., 0.}, 0.3)};
+  const Isometry end{Isometry::fromTranslation({-2., 0.5, 4.}) *
+                     Isometry::rotateAround({0., 1., 2.}, 1.2)};
+  const std::vector<Interpolation> modes{
+      Interpolation::kScrew, Interpolation::kSlerp, Interpolation::kNlerp};
+
+  for (const Interpolation mode : modes) {
+    EXPECT_EQ(interpolate(start, end, 0., mode), start);
+    EXPECT_EQ(interpolate(start, end, 1., mode), end);
+    // Rotation between equal rotations, translation along the line.
+    EXPECT_EQ(interpolate(Isometry::fromTranslation({2., 0., 0.}),
+                          Isometry::fromTranslation({4., 2., 0.}), 0.25,
+                          mode),
+              Isometry::fromTranslation({2.5, 0.5, 0.}));
+  }
+
+  // A quarter turn around the vertical line through (1, 0, 0). The screw
+  // stays on the circle, the others cut through it.
+  const Isometry pivot{Isometry::fromTranslation({1., 0., 0.})};
+  const Isometry turn{pivot * Isometry::rotateAround(Vector3::kUnitZ,
+                                                     M_PI / 2.) *
+                      pivot.inverse()};
+  const Isometry half_turn{pivot * Isometry::rotateAround(Vector3::kUnitZ,
+                                                          M_PI / 4.) *
+                           pivot.inverse()};
+  EXPECT_EQ(interpolate(Isometry::kIdentity, turn, 0.5,
+                        Interpolation::kScrew),
+            half_turn);
+  EXPECT_EQ(interpolate(Isometry::kIdentity, turn, 0.5,
+                        Interpolation::kSlerp),
+            Isometry(Vector3(0.5, -0.5, 0.), half_turn.rotation()));
+
+  // Slerp keeps a constant angular velocity, also for tiny steps.
+  for (const double angle : {1e-6, 1e-2, 0.5, 3.}) {
+    const IsometryInterpolator interpolator(
+        start, start * Isometry::rotateAround({0., 1., 2.}, angle));
+    EXPECT_NEAR(interpolator.angle(), angle, 1e-12);
+    for (const double t : {0.1, 0.3, 0.7}) {
+      EXPECT_NEAR(angleBetween(start, interpolator.evaluate(t)), t * angle,
+                  1e-12);
+    }
+  }
+
+  // Goes the short way across the half turn.
+  EXPECT_EQ(interpolate(Isometry::rotateAround(Vector3::kUnitZ, 3.),
+                        Isometry::rotateAround(Vector3::kUnitZ, -3.), 0.5),
+            Isometry::rotateAround(Vector3::kUnitZ, M_PI));
+
+  // The nlerp error stays under the bound, which is tight for small angles.
+  for (const double angle : {0.01, 0.1, 1., 3.}) {
+    const Isometry target{start * Isometry::rotateAround({3., -1., 1.},
+                                                         angle)};
+    const IsometryInterpolator slerp(start, target, Interpolation::kSlerp);
+    const IsometryInterpolator nlerp(start, target, Interpolation::kNlerp);
+    double error{0.};
+    for (int i = 0; i <= 100; ++i) {
+      error = std::max(error, angleBetween(slerp.evaluate(i / 100.),
+                                           nlerp.evaluate(i / 100.)));
+    }
+    EXPECT_LE(error, nlerpErrorBound(angle));
+    if (angle > 0.05) {
+      EXPECT_GT(error, 0.9 * nlerpErrorBound(angle));
+    }
+  }
+  EXPECT_NEAR(nlerpErrorBound(0.1), 4.01e-6, 1e-8);
+
+  // Batched evaluation matches the single one.
+  std::vector<double> ts;
+  for (int i = -2; i <= 12; ++i) {
+    ts.push_back(i / 10.);
+  }
+  for (const Interpolation mode : modes) {
+    const IsometryInterpolator interpolator(start, end, mode);
+    EXPECT_EQ(interpolator.mode(), mode);
+    std::vector<Isometry> results(ts.size());
+    interpolator.evaluate(ts.data(), results.data(), ts.size());
+    for (std::size_t i = 0; i < ts.size(); ++i) {
+      EXPECT_EQ(results[i], interpolate(start, end, ts[i], mode));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <sstream>
+
+#include <isometry/isometry2.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(Isometry2Test, Isometry2FullTests) {
+  const double kTolerance{1e-12};
+  const Isometry2 t1{1., 2., M_PI / 2.};
+  const Isometry2 t2{Vector2{-0.5, 3.}, 2.5};
+  const Vector2 p{0.25, -4.};
+
+  constexpr Isometry2 kOrigin{};
+  EXPECT_EQ(kOrigin, Isometry2::kIdentity);
+  EXPECT_EQ(t1.x(), 1.);
+  EXPECT_EQ(t1.y(), 2.);
+  EXPECT_EQ(t1.translation(), Vector2(1., 2.));
+  EXPECT_NEAR(t1.theta(), M_PI / 2., kTolerance);
+  EXPECT_NEAR(Isometry2(0., 0., 2.5 * M_PI).theta(), M_PI / 2., kTolerance);
+  EXPECT_EQ(t1.rotation(), Matrix2(0., -1., 1., 0.));
+  EXPECT_EQ(t1 * Vector2(1., 0.), Vector2(1., 3.));
+  EXPECT_EQ(t1.inverse() * (t1 * p), p);
+  EXPECT_EQ(t1.inverseTransform(p), t1.inverse() * p);
+  EXPECT_EQ(t1 * t1.inverse(), Isometry2::kIdentity);
+  EXPECT_EQ((t1 * t2) * p, t1 * (t2 * p));
+  EXPECT_NEAR((t1 * t2).theta(), M_PI / 2. + 2.5 - 2. * M_PI, kTolerance);
+  EXPECT_NE(t1, t2);
+  Isometry2 t3{t1};
+  t3 *= t2;
+  EXPECT_EQ(t3, t1.compose(t2));
+
+  // Matches the 3D isometry, and converts back without loss.
+  const Isometry t1_3d{t1.toIsometry()};
+  EXPECT_EQ(t1_3d, Isometry(Vector3(1., 2., 0.),
+                            Matrix3::rotationZ(M_PI / 2.)));
+  EXPECT_EQ((t1 * t2).toIsometry(), t1_3d * t2.toIsometry());
+  const Vector3 p_3d{(t1_3d * Vector3(0.25, -4., 0.))};
+  EXPECT_EQ(Vector2(p_3d.x(), p_3d.y()), t1 * p);
+  const Isometry2 back{Isometry2::fromIsometry(t1_3d)};
+  EXPECT_EQ(back.cos(), t1.cos());
+  EXPECT_EQ(back.sin(), t1.sin());
+  EXPECT_EQ(back.translation(), t1.translation());
+  EXPECT_THROW(Isometry2::fromIsometry(Isometry::fromEulerAngles(0.1, 0., 0.)),
+               std::invalid_argument);
+  EXPECT_THROW(Isometry2::fromIsometry(
+                   Isometry::fromTranslation(Vector3(0., 0., 1.))),
+               std::invalid_argument);
+
+  // Long chains keep a unit rotation.
+  Isometry2 chain;
+  const Isometry2 step{0.01, 0., 0.001};
+  for (int i = 0; i < 100000; ++i) {
+    chain *= step;
+  }
+  EXPECT_NEAR(chain.cos() * chain.cos() + chain.sin() * chain.sin(), 1.,
+              kTolerance);
+  EXPECT_NEAR(chain.theta(), std::remainder(100., 2. * M_PI), 1e-9);
+
+  Vector2 points[5];
+  Vector2 results[5];
+  for (int i = 0; i < 5; ++i) {
+    points[i] = Vector2(i, -2. * i);
+  }
+  transform(t2, points, results, 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(results[i], t2 * points[i]);
+  }
+  inverseTransform(t2, results, results, 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(results[i], points[i]);
+  }
+
+  std::stringstream ss;
+  ss << Isometry2(1., 2., 0.5);
+  EXPECT_EQ(ss.str(), "[T: (x: 1, y: 2), theta: 0.5]");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
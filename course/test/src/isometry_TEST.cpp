@@ -9,6 +9,7 @@
  * needed to implement an isometry.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <string>
@@ -70,6 +71,7 @@ GTEST_TEST(IsometryTest, IsometryFullTests) {
   EXPECT_EQ(t1.transform(Vector3(std::initializer_list<double>({1., 1., 1.}))),
             Vector3(2., 3., 4.));
   EXPECT_EQ(t1.inverse() * Vector3(2., 3., 4.), Vector3(1., 1., 1.));
+  EXPECT_EQ(t1.inverseTransform(Vector3(2., 3., 4.)), Vector3(1., 1., 1.));
   EXPECT_EQ(t1 * t2 * Vector3(1., 1., 1.), Vector3(3., 5., 7.));
   EXPECT_EQ(t1.compose(t2) * Vector3(1., 1., 1.), Vector3(3., 5., 7.));
 
@@ -109,6 +111,120 @@ GTEST_TEST(IsometryTest, IsometryFullTests) {
   EXPECT_EQ(t9 * Vector3(1., 1., 1.), Vector3(3., 5., 7.));
 }
 
+double orthonormalityError(const Matrix3 &matrix) {
+  const Matrix3 error =
+      matrix.product(matrix.transpose()) - Matrix3::kIdentity;
+  double worst{0.};
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      worst = std::max(worst, std::abs(error[i][j]));
+    }
+  }
+  return worst;
+}
+
+GTEST_TEST(IsometryTest, IsometryRenormalizationTests) {
+  const double kTolerance{1e-12};
+  const Isometry rotation{Isometry::fromEulerAngles(0.1, -0.2, 0.3)};
+  const Matrix3 drift{1e-5, -2e-5, 0., 3e-5, 0., 1e-5, 0., 2e-5, -1e-5};
+  const Isometry drifted{Vector3{1., 2., 3.}, rotation.rotation() + drift};
+  const double drift_error{orthonormalityError(drifted.rotation())};
+
+  // The fast correction is first order, the residual is quadratic in drift.
+  Isometry fast{drifted};
+  fast.renormalize();
+  EXPECT_LT(orthonormalityError(fast.rotation()),
+            10. * drift_error * drift_error);
+  EXPECT_NEAR(fast.rotation().det(), 1., 1e-8);
+  EXPECT_EQ(fast.translation(), drifted.translation());
+  EXPECT_TRUE(areAlmostEqual(fast.rotation(), rotation.rotation(), 1e-4));
+
+  Isometry exact{drifted};
+  exact.renormalize(Renormalization::kExact);
+  EXPECT_LT(orthonormalityError(exact.rotation()), kTolerance);
+  EXPECT_NEAR(exact.rotation().det(), 1., kTolerance);
+
+  Matrix3 matrix{rotation.rotation()};
+  EXPECT_TRUE(areAlmostEqual(matrix.renormalize(), rotation.rotation(),
+                             kTolerance));
+
+  // Long composition chains stay on SO(3) with the periodic policy.
+  const Isometry step{Vector3{0., 0., 0.}, rotation.rotation() + drift * 1e-3};
+  Isometry unbounded{Isometry::kIdentity};
+  RenormalizingIsometry bounded(10);
+  EXPECT_EQ(bounded.period(), 10u);
+  EXPECT_EQ(bounded.isometry(), Isometry::kIdentity);
+  for (int i = 0; i < 1000; ++i) {
+    unbounded *= step;
+    bounded *= step;
+  }
+  EXPECT_GT(orthonormalityError(unbounded.rotation()), 1e-5);
+  EXPECT_LT(orthonormalityError(bounded.isometry().rotation()), 1e-6);
+  EXPECT_EQ(bounded.compositions(), 0u);
+  const RenormalizingIsometry next = bounded * step;
+  EXPECT_EQ(next.period(), 10u);
+  EXPECT_EQ(next.compositions(), 1u);
+  EXPECT_EQ(bounded.compositions(), 0u);
+  EXPECT_EQ(next.isometry(), bounded.isometry() * step);
+
+  // A zero period never renormalizes.
+  RenormalizingIsometry disabled(0);
+  for (int i = 0; i < 1000; ++i) {
+    disabled *= step;
+  }
+  EXPECT_EQ(disabled.compositions(), 1000u);
+  EXPECT_GT(orthonormalityError(disabled.isometry().rotation()), 1e-5);
+
+  // The policy does not weigh on plain isometries.
+  static_assert(sizeof(Isometry) == 12 * sizeof(double),
+                "Isometry holds only its translation and rotation");
+}
+
+GTEST_TEST(IsometryTest, IsometryConstexprTests) {
+  const double kTolerance{1e-12};
+  // Lidar mounted 30cm above and 10cm ahead of the base, facing left.
+  constexpr Isometry kBaseToLidar{Vector3(0.1, 0., 0.3),
+                                  Matrix3::rotationZ(M_PI / 2.)};
+  constexpr Vector3 kPoint{kBaseToLidar.transform(Vector3(1., 0., 0.))};
+  static_assert(kPoint.z() == 0.3, "transforms fold at compile time");
+  static_assert(kPoint.y() == 1., "transforms fold at compile time");
+  static_assert(Isometry::fromTranslation(Vector3(1., 2., 3.))
+                    .rotation()[2][2] == 1.,
+                "translations are built at compile time");
+
+  EXPECT_TRUE(areAlmostEqual(
+      kBaseToLidar,
+      Isometry::fromTranslation(Vector3(0.1, 0., 0.3)) *
+          Isometry::rotateAround(Vector3::kUnitZ, M_PI / 2.),
+      kTolerance));
+  EXPECT_EQ(kPoint, Vector3(0.1, 1., 0.3));
+  static_assert(kBaseToLidar.inverseTransform(kPoint).x() == 1.,
+                "inverse transforms fold at compile time");
+}
+
+GTEST_TEST(IsometryTest, IsometryEulerAnglesTests) {
+  const double kTolerance{1e-12};
+  const Vector3 angles[]{Vector3{0.1, -0.2, 0.3}, Vector3{-2., 1.5, 3.},
+                         Vector3{M_PI, -M_PI / 2., 0.7}, Vector3::kZero};
+  Isometry results[4];
+  Isometry::fromEulerAngles(angles, results, 4);
+  for (int i = 0; i < 4; ++i) {
+    const Vector3& a = angles[i];
+    const Isometry expected{Isometry::rotateAround(Vector3::kUnitX, a.x()) *
+                            Isometry::rotateAround(Vector3::kUnitY, a.y()) *
+                            Isometry::rotateAround(Vector3::kUnitZ, a.z())};
+    EXPECT_TRUE(areAlmostEqual(
+        Isometry::fromEulerAngles(a.x(), a.y(), a.z()), expected, kTolerance));
+    EXPECT_TRUE(areAlmostEqual(results[i], expected, kTolerance));
+  }
+  EXPECT_EQ(results[3], Isometry::kIdentity);
+
+  const Isometry pose{Vector3{1., -2., 0.5}, results[1].rotation()};
+  const Vector3 point{0.5, -4., 2.};
+  EXPECT_EQ(pose.inverseTransform(point), pose.inverse() * point);
+  EXPECT_EQ(pose.inverseTransform(pose * point), point);
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace math
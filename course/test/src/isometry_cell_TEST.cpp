@@ -0,0 +1,141 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <isometry/isometry_cell.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+// Every element holds value, so a torn read shows up as a mix of values.
+Isometry filledWith(const double value) {
+  return {Vector3(value, value, value),
+          Matrix3(value, value, value, value, value, value,
+                  value, value, value)};
+}
+
+bool isFilled(const Isometry &isometry, double *value) {
+  *value = isometry.translation().x();
+  for (int i = 0; i < 3; ++i) {
+    if (isometry.translation()[i] != *value) {
+      return false;
+    }
+    for (int j = 0; j < 3; ++j) {
+      if (isometry.rotation()[i][j] != *value) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+GTEST_TEST(IsometryCellTest, IsometryCellFullTests) {
+  const Isometry pose{Isometry::fromTranslation({1., 2., 3.}) *
+                      Isometry::rotateAround({1., 0., 1.}, 0.3)};
+  IsometryCell cell;
+  EXPECT_EQ(cell.version(), 0u);
+  EXPECT_EQ(cell.load(), Isometry::kIdentity);
+
+  cell.store(pose);
+  EXPECT_EQ(cell.version(), 1u);
+  EXPECT_EQ(cell.load(), pose);
+  Isometry result;
+  EXPECT_TRUE(cell.tryLoad(&result));
+  EXPECT_EQ(result, pose);
+
+  const IsometryCell initialized(pose);
+  EXPECT_EQ(initialized.version(), 0u);
+  EXPECT_EQ(initialized.load(), pose);
+}
+
+// Run it in a -DSANITIZE_THREAD=ON build to check for data races too.
+GTEST_TEST(IsometryCellTest, IsometryCellStressTests) {
+  const int kMinStores{20000};
+  // Stores after which the writer gives up waiting for an overlap.
+  const int kMaxStores{20000000};
+  const int kMinReads{20000};
+  const int kReaders{4};
+  IsometryCell cell(filledWith(0.));
+  std::atomic<int> running{0};
+  std::atomic<int> reads{0};
+  // Reads during which the cell was written.
+  std::atomic<int> overlaps{0};
+  std::atomic<bool> done{false};
+  std::vector<int> torn(kReaders, 0);
+  std::vector<int> backwards(kReaders, 0);
+
+  std::vector<std::thread> readers;
+  for (int reader = 0; reader < kReaders; ++reader) {
+    readers.emplace_back([&, reader]() {
+      double last{0.};
+      double value{0.};
+      ++running;
+      while (!done.load()) {
+        const std::uint64_t version = cell.version();
+        if (!isFilled(cell.load(), &value)) {
+          ++torn[reader];
+        }
+        if (cell.version() != version) {
+          ++overlaps;
+        }
+        if (value < last) {
+          ++backwards[reader];
+        }
+        last = value;
+        Isometry result;
+        if (!cell.tryLoad(&result)) {
+          ++overlaps;
+        } else if (!isFilled(result, &value)) {
+          ++torn[reader];
+        }
+        ++reads;
+      }
+    });
+  }
+  // Writes only once every reader is running, and until they have all
+  // had the chance to read in the middle of a store.
+  while (running.load() < kReaders) {
+    std::this_thread::yield();
+  }
+  int stores{0};
+  while (stores < kMinStores || reads.load() < kMinReads ||
+         (overlaps.load() == 0 && stores < kMaxStores)) {
+    cell.store(filledWith(++stores));
+  }
+  done.store(true);
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+
+  for (int reader = 0; reader < kReaders; ++reader) {
+    EXPECT_EQ(torn[reader], 0);
+    EXPECT_EQ(backwards[reader], 0);
+  }
+  EXPECT_GE(reads.load(), kMinReads);
+  EXPECT_GT(overlaps.load(), 0);
+  EXPECT_EQ(cell.version(), static_cast<std::uint64_t>(stores));
+  double value{0.};
+  EXPECT_TRUE(isFilled(cell.load(), &value));
+  EXPECT_EQ(value, stores);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
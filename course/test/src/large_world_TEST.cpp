@@ -0,0 +1,96 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include <isometry/large_world.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+double distance(const Vector3 &a, const Vector3 &b) {
+  return (a - b).norm();
+}
+
+GTEST_TEST(LargeWorldTest, LargeWorldIsometryFullTests) {
+  // A vehicle 20 km away from the map origin.
+  const Isometry pose{Vector3{20000.25, -35000.5, 12.125},
+                      Isometry::fromEulerAngles(0.01, -0.02, 2.3).rotation()};
+  const Isometry step{Vector3{1.5, 0.1, 0.},
+                      Isometry::fromEulerAngles(0., 0., 0.05).rotation()};
+  const LargeWorldIsometry large{pose};
+  const LargeWorldIsometry large_step{step};
+
+  EXPECT_EQ(LargeWorldIsometry().toIsometry(), Isometry::kIdentity);
+  EXPECT_EQ(large.translation(), pose.translation());
+  EXPECT_EQ(large.toIsometry(), pose);
+  EXPECT_LE(sizeof(LargeWorldIsometry), 64u);
+
+  // Points up to 100 m away stay within the documented 1e-7 * range.
+  const Vector3 point{80., -55., 3.};
+  const Vector3f point_f{80.f, -55.f, 3.f};
+  EXPECT_LT(distance(large * point, pose * point), 1e-7 * point.norm());
+  EXPECT_LT(distance(large * point_f, pose * point), 1e-7 * point.norm());
+  EXPECT_LT(distance(large.inverse() * (large * point), point), 1e-5);
+  EXPECT_LT(distance((large * large_step) * point, pose * step * point),
+            2e-7 * point.norm());
+  EXPECT_EQ(large.compose(large_step), large * large_step);
+  EXPECT_NE(large, large_step);
+
+  std::stringstream ss;
+  ss << LargeWorldIsometry();
+  EXPECT_EQ(ss.str(),
+            "[T: (x: 0, y: 0, z: 0), R:[[1, 0, 0], [0, 1, 0], [0, 0, 1]]]");
+}
+
+GTEST_TEST(LargeWorldTest, LocalOriginFullTests) {
+  const Vector3 map_origin{20000., -35000., 0.};
+  const Isometry pose{Vector3{20010.25, -34990.5, 1.125},
+                      Isometry::fromEulerAngles(0.01, -0.02, 2.3).rotation()};
+  LocalOrigin origin{map_origin};
+  EXPECT_EQ(origin.origin(), map_origin);
+
+  // 0.06 mm resolution at 1 km from the origin.
+  const Vector3 world{map_origin + Vector3{987.654321, -123.456789, 4.5}};
+  EXPECT_LT(distance(origin.toWorld(origin.toLocal(world)), world), 1e-4);
+  // Rounding world coordinates themselves to float would lose decimeters.
+  EXPECT_GT(std::abs(static_cast<float>(world.y()) - world.y()), 1e-4);
+
+  std::vector<Vector3f> points;
+  for (int i = 0; i < 100; ++i) {
+    points.emplace_back(0.5f * i, -0.25f * i, 0.1f);
+  }
+  std::vector<Vector3f> local(points.size());
+  origin.transform(LargeWorldIsometry{pose}, points.data(), local.data(),
+                   points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const Vector3 expected{pose * Vector3(points[i](0, 0), points[i](1, 0),
+                                          points[i](2, 0))};
+    EXPECT_LT(distance(origin.toWorld(local[i]), expected), 1e-5);
+  }
+
+  const Vector3 new_origin{map_origin + Vector3{500., 500., 0.}};
+  const Vector3 before{origin.toWorld(local[42])};
+  origin.rebase(new_origin, local.data(), local.size());
+  EXPECT_EQ(origin.origin(), new_origin);
+  EXPECT_LT(distance(origin.toWorld(local[42]), before), 1e-4);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,62 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <isometry/lazy.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(LazyTest, LazyFullTests) {
+  const Isometry t1 = Isometry::fromTranslation(Vector3{1., 2., 3.});
+  const Isometry t2{Vector3{1., 2., 3.}, Matrix3::kIdentity};
+  const Isometry t3{Vector3{-1., 0.5, 2.},
+                    Isometry::fromEulerAngles(0.3, -0.2, 1.1).rotation()};
+  const Isometry t4{Isometry::rotateAround(Vector3::kUnitZ, M_PI / 2.)};
+
+  // Same results as the eager products in isometry_TEST.
+  EXPECT_EQ(lazy(t1) * t2 * Vector3(1., 1., 1.), Vector3(3., 5., 7.));
+  EXPECT_EQ(lazy(t1) * Vector3(1., 1., 1.), Vector3(2., 3., 4.));
+  const Isometry folded = lazy(t1) * t3 * t4;
+  EXPECT_EQ(folded, t1 * t3 * t4);
+  EXPECT_EQ((lazy(t1) * t3 * t4).evaluate(), t1 * t3 * t4);
+  EXPECT_EQ(&(lazy(t1) * t3).factor(1), &t3);
+  EXPECT_EQ(lazy(t3) * t4 * t1 * Vector3(0.5, -4., 2.),
+            t3 * t4 * t1 * Vector3(0.5, -4., 2.));
+
+  // Both evaluation orders agree, below and above the folding size.
+  Vector3 points[2 * kFoldingBatchSize];
+  for (std::size_t i = 0; i < 2 * kFoldingBatchSize; ++i) {
+    points[i] = Vector3{static_cast<double>(i), -1., 0.5 * i};
+  }
+  for (std::size_t count : {kFoldingBatchSize, 2 * kFoldingBatchSize}) {
+    Vector3 results[2 * kFoldingBatchSize];
+    (lazy(t3) * t4 * t2).transform(points, results, count);
+    for (std::size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(results[i], t3 * t4 * t2 * points[i]);
+    }
+  }
+  Vector3 in_place[2 * kFoldingBatchSize];
+  std::copy(points, points + 2 * kFoldingBatchSize, in_place);
+  lazy(t4).transform(in_place, in_place, 2 * kFoldingBatchSize);
+  EXPECT_EQ(in_place[3], t4 * points[3]);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,157 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <isometry/lie.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+double maxError(const Matrix3 &obj1, const Matrix3 &obj2) {
+  double error{0.};
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      error = std::max(error, std::abs(obj1[i][j] - obj2[i][j]));
+    }
+  }
+  return error;
+}
+
+double maxError(const Vector3 &obj1, const Vector3 &obj2) {
+  return std::max({std::abs(obj1.x() - obj2.x()),
+                   std::abs(obj1.y() - obj2.y()),
+                   std::abs(obj1.z() - obj2.z())});
+}
+
+Vector3 scaled(const Vector3 &axis, const double angle) {
+  Vector3 result{axis / axis.norm()};
+  result *= angle;
+  return result;
+}
+
+GTEST_TEST(LieTest, SO3FullTests) {
+  const double kTolerance{1e-14};
+  const Vector3 axis{1., -2., 0.5};
+
+  EXPECT_EQ(expSO3(Vector3::kZero), Matrix3::kIdentity);
+  EXPECT_EQ(logSO3(Matrix3::kIdentity), Vector3::kZero);
+  EXPECT_LT(maxError(expSO3(scaled(Vector3::kUnitZ, M_PI / 8.)),
+                     Isometry::rotateAround(Vector3::kUnitZ, M_PI / 8.)
+                         .rotation()),
+            kTolerance);
+
+  // Round trips across the small angle, generic and half turn branches.
+  for (const double angle : {0., 1e-9, 1e-5, 9.99e-3, 1.001e-2, 0.5, 2.,
+                             2.7, 3.1, M_PI - 1e-7, M_PI}) {
+    const Vector3 omega{scaled(axis, angle)};
+    const Matrix3 rotation{expSO3(omega)};
+    EXPECT_LT(maxError(rotation,
+                       angle == 0. ? Matrix3::kIdentity
+                                   : Isometry::rotateAround(axis, angle)
+                                         .rotation()),
+              kTolerance) << angle;
+    // At exactly pi, omega and -omega are the same rotation.
+    const Vector3 log{logSO3(rotation)};
+    EXPECT_LT(std::min(maxError(log, omega), maxError(log, omega * -1)),
+              1e-12) << angle;
+    EXPECT_LT(maxError(rotation.product(rotation.transpose()),
+                       Matrix3::kIdentity), kTolerance) << angle;
+  }
+  // Half turns about each axis, where sin(angle) vanishes.
+  for (const Vector3 &unit : {Vector3::kUnitX, Vector3::kUnitY,
+                              Vector3::kUnitZ}) {
+    const Vector3 omega{logSO3(expSO3(scaled(unit, M_PI)))};
+    EXPECT_NEAR(omega.norm(), M_PI, kTolerance);
+    EXPECT_NEAR(std::abs(omega.dot(unit)), M_PI, kTolerance);
+  }
+
+  Vector3 omegas[3]{Vector3{0.1, 0.2, 0.3}, Vector3::kZero,
+                    Vector3{-2., 1., 0.5}};
+  Matrix3 rotations[3];
+  Vector3 logs[3];
+  expSO3(omegas, rotations, 3);
+  logSO3(rotations, logs, 3);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(rotations[i], expSO3(omegas[i]));
+    EXPECT_LT(maxError(logs[i], omegas[i]), 1e-12);
+  }
+}
+
+GTEST_TEST(LieTest, SE3FullTests) {
+  const double kTolerance{1e-12};
+  const Twist twist{Vector3{1., -2., 0.5}, Vector3{0.3, -0.2, 0.9}};
+
+  EXPECT_EQ(expSE3(Twist{Vector3::kZero, Vector3::kZero}),
+            Isometry::kIdentity);
+  // Pure translations and pure rotations.
+  EXPECT_EQ(expSE3(Twist{Vector3{1., 2., 3.}, Vector3::kZero}),
+            Isometry::fromTranslation(Vector3{1., 2., 3.}));
+  EXPECT_EQ(logSE3(Isometry::fromTranslation(Vector3{1., 2., 3.})),
+            (Twist{Vector3{1., 2., 3.}, Vector3::kZero}));
+  // A screw motion: a quarter turn about z while advancing 1 along it,
+  // around an axis through (1, 0, 0).
+  const Isometry screw{expSE3(Twist{Vector3{0., -M_PI / 2., 1.},
+                                    Vector3{0., 0., M_PI / 2.}})};
+  EXPECT_EQ(screw * Vector3(1., 0., 0.), Vector3(1., 0., 1.));
+  EXPECT_EQ(screw * Vector3(2., 0., 0.), Vector3(1., 1., 1.));
+
+  for (const double scale : {0., 1e-9, 1e-4, 1e-2, 0.5, 1., 3.}) {
+    const Twist scaled_twist{twist * scale};
+    const Isometry isometry{expSE3(scaled_twist)};
+    const Twist back{logSE3(isometry)};
+    EXPECT_LT(maxError(back.linear, scaled_twist.linear), kTolerance)
+        << scale;
+    EXPECT_LT(maxError(back.angular, scaled_twist.angular), kTolerance)
+        << scale;
+    // exp(s * xi) * exp(t * xi) = exp((s + t) * xi).
+    EXPECT_EQ(isometry * isometry, expSE3(scaled_twist * 2.));
+  }
+  const Isometry half_turn{Vector3{1., 2., 3.},
+                           expSO3(Vector3{0., M_PI, 0.})};
+  EXPECT_EQ(expSE3(logSE3(half_turn)), half_turn);
+
+  // Adjoint: T * exp(xi) * T^-1 = exp(Ad(T) * xi).
+  const Isometry pose{Vector3{-1., 0.5, 2.},
+                      Isometry::fromEulerAngles(-1., 0.4, 2.).rotation()};
+  EXPECT_EQ(pose * expSE3(twist) * pose.inverse(),
+            expSE3(adjoint(pose, twist)));
+
+  EXPECT_EQ(Twist::fromVector(twist.vector()), twist);
+  EXPECT_EQ(twist.vector(), Vector6(1., -2., 0.5, 0.3, -0.2, 0.9));
+  EXPECT_EQ(twist + twist - twist, twist);
+  EXPECT_NE(twist * 2., twist);
+
+  Twist twists[2]{twist, twist * 1e-5};
+  Isometry isometries[2];
+  Twist logs[2];
+  expSE3(twists, isometries, 2);
+  logSE3(isometries, logs, 2);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(isometries[i], expSE3(twists[i]));
+    EXPECT_EQ(logs[i], twists[i]);
+  }
+
+  std::stringstream ss;
+  ss << Twist{Vector3{1., 2., 3.}, Vector3::kZero};
+  EXPECT_EQ(ss.str(), "[v: (x: 1, y: 2, z: 3), w: (x: 0, y: 0, z: 0)]");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
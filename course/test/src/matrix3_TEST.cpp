@@ -128,6 +128,87 @@ GTEST_TEST(Matrix3Test, Matrix3FullTests) {
   EXPECT_EQ(m4_moved[2][2], 10);
 }
 
+GTEST_TEST(Matrix3Test, Matrix3InverseTests) {
+  const double kTolerance{1e-12};
+  const Matrix3 m1{1., 2., 3., 4., 5., 6., 7., 8., 10.};
+  const Matrix3 m2{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  const Matrix3 m3{0., -1., 0., 1., 0., 0., 0., 0., 1.};
+
+  const Matrix3 m1_inverse = m1.inverse();
+  const Matrix3 identity = m1.product(m1_inverse);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_NEAR(identity[i][j], Matrix3::kIdentity[i][j], kTolerance);
+    }
+  }
+  EXPECT_EQ(m1_inverse, Matrix3({-2. / 3., -4. / 3., 1., -2. / 3., 11. / 3.,
+                                 -2., 1., -2., 1.}));
+  EXPECT_EQ(m3.inverse(), m3.transpose());
+  EXPECT_EQ(Matrix3::kIdentity.inverse(), Matrix3::kIdentity);
+  EXPECT_EQ((m1 * 1e-6).inverse(), m1_inverse * 1e6);
+
+  EXPECT_ANY_THROW(m2.inverse());
+  EXPECT_ANY_THROW(Matrix3::kZero.inverse());
+  EXPECT_ANY_THROW(Matrix3::kOnes.inverse());
+  // Entries whose cube overflows or underflows a double.
+  const Matrix3 large{Matrix3::kIdentity * 1e150};
+  EXPECT_EQ(large.inverse() * 1e150, Matrix3::kIdentity);
+  EXPECT_EQ((m1 * 1e-150).inverse() * 1e-150, m1_inverse);
+  EXPECT_ANY_THROW((Matrix3::kOnes * 1e200).inverse());
+
+  Matrix3 result{Matrix3::kOnes};
+  EXPECT_FALSE(m2.tryInverse(&result));
+  EXPECT_EQ(result, Matrix3::kOnes);
+  EXPECT_TRUE(m3.tryInverse(&result));
+  EXPECT_EQ(result, m3.transpose());
+
+  const Matrix3 matrices[]{m1, m2, m3};
+  Matrix3 results[3];
+  bool invertible[3];
+  EXPECT_EQ(Matrix3::tryInverse(matrices, results, invertible, 3), 2u);
+  EXPECT_TRUE(invertible[0]);
+  EXPECT_FALSE(invertible[1]);
+  EXPECT_TRUE(invertible[2]);
+  EXPECT_EQ(results[0], m1_inverse);
+  EXPECT_EQ(results[1], Matrix3::kZero);
+  EXPECT_EQ(results[2], m3.transpose());
+  EXPECT_EQ(Matrix3::tryInverse(matrices, results, nullptr, 3), 2u);
+}
+
+GTEST_TEST(Matrix3Test, Matrix3ConstexprTests) {
+  const double kTolerance{1e-14};
+  constexpr Matrix3 kRx{Matrix3::rotationX(M_PI / 3.)};
+  constexpr Matrix3 kRy{Matrix3::rotationY(-M_PI / 5.)};
+  constexpr Matrix3 kRz{Matrix3::rotationZ(M_PI / 2.)};
+  constexpr Matrix3 kMount{kRz.product(kRx).product(kRy)};
+
+  static_assert(kRz[0][0] < 1e-15 && kRz[0][0] > -1e-15,
+                "cos(pi / 2) folds at compile time");
+  static_assert(kRz[1][0] == 1., "sin(pi / 2) folds at compile time");
+  static_assert(kMount.det() > 1. - 1e-12 && kMount.det() < 1. + 1e-12,
+                "products of rotations are rotations");
+  static_assert(kRx.transpose().product(kRx)[1][1] > 1. - 1e-12,
+                "rotations are orthonormal");
+  static_assert((kRz * Vector3(1., 0., 0.)).y() == 1.,
+                "matrix vector products fold at compile time");
+  static_assert(kRz.row(1).x() == kRz.col(0).y(), "rows and columns agree");
+
+  const double c{std::cos(M_PI / 3.)};
+  const double s{std::sin(M_PI / 3.)};
+  const Matrix3 rx{1., 0., 0., 0., c, -s, 0., s, c};
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_NEAR(kRx[i][j], rx[i][j], kTolerance);
+    }
+  }
+  for (double angle = -10.; angle < 10.; angle += 0.01) {
+    EXPECT_NEAR(constexprSin(angle), std::sin(angle), kTolerance);
+    EXPECT_NEAR(constexprCos(angle), std::cos(angle), kTolerance);
+  }
+  EXPECT_EQ(Matrix3::rotationY(0.), Matrix3::kIdentity);
+  EXPECT_ANY_THROW(kMount.col(3));
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace math
@@ -0,0 +1,106 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include <isometry/isometry.hpp>
+#include <isometry/matrixn.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(MatrixNTest, MatrixNFullTests) {
+  const Matrix2 m1{1., 2., 3., 4.};
+  const Matrix2 m2{5., 6., 7., 8.};
+  Matrix2 m3;
+
+  EXPECT_EQ(m3, Matrix2::zero());
+  EXPECT_EQ(Matrix2::identity(), Matrix2(1., 0., 0., 1.));
+  EXPECT_EQ(m1 + m2, Matrix2(6., 8., 10., 12.));
+  EXPECT_EQ(m2 - m1, Matrix2(4., 4., 4., 4.));
+  EXPECT_EQ(m1 * m2, Matrix2(5., 12., 21., 32.));
+  EXPECT_EQ(m2 / m1, Matrix2(5., 3., 7. / 3., 2.));
+  EXPECT_EQ(m1 * 2., Matrix2(2., 4., 6., 8.));
+  EXPECT_EQ(2. * m1, Matrix2(2., 4., 6., 8.));
+  EXPECT_EQ(m1 / 2., Matrix2(.5, 1., 1.5, 2.));
+  EXPECT_EQ(m1.product(m2), Matrix2(19., 22., 43., 50.));
+  EXPECT_EQ(m1.transpose(), Matrix2(1., 3., 2., 4.));
+  EXPECT_EQ(m1.product(Vector2(1., 1.)), Vector2(3., 7.));
+  EXPECT_TRUE(m1 != m2);
+
+  EXPECT_EQ(m3 += m1, m1);
+  EXPECT_EQ(m3 *= m2, Matrix2(5., 12., 21., 32.));
+  EXPECT_EQ(m3 /= m2, m1);
+  EXPECT_EQ(m3 -= m1, Matrix2::zero());
+  m3(0, 1) = 3.;
+  m3.at(1, 0) = 4.;
+  EXPECT_EQ(m3(0, 1), 3.);
+  EXPECT_EQ(m3.at(1, 0), 4.);
+  EXPECT_EQ(m3.data()[1], 3.);
+  EXPECT_ANY_THROW(m3.at(2, 0));
+  EXPECT_ANY_THROW(m1.at(0, 2));
+
+  // Non square products and dimensions beyond three.
+  const MatrixN<2, 3> a{1., 2., 3., 4., 5., 6.};
+  const MatrixN<3, 2> b{a.transpose()};
+  EXPECT_EQ(a.product(b), Matrix2(14., 32., 32., 77.));
+  EXPECT_EQ(b(2, 1), 6.);
+
+  Matrix6 covariance{Matrix6::identity() * 4.};
+  covariance(0, 5) = covariance(5, 0) = 1.;
+  Vector6 twist;
+  twist(5, 0) = 1.;
+  EXPECT_EQ(covariance.product(twist), Vector6(1., 0., 0., 0., 0., 4.));
+  EXPECT_EQ(covariance.product(Matrix6::identity()), covariance);
+
+  // Homogeneous coordinates agree with Isometry.
+  const Isometry isometry{Vector3{1., 2., 3.},
+                          Matrix3::rotationZ(M_PI / 2.)};
+  const Matrix4 homogeneous{isometry.matrix()};
+  const Vector4 point{homogeneous.product(Vector4(1., 0., 0., 1.))};
+  EXPECT_EQ(Vector3(point(0, 0), point(1, 0), point(2, 0)),
+            isometry * Vector3(1., 0., 0.));
+  EXPECT_EQ(point(3, 0), 1.);
+  EXPECT_EQ(homogeneous.product(isometry.inverse().matrix()),
+            Matrix4::identity());
+
+  // Vector3 and Matrix3 wrap the same storage.
+  const Vector3 v{1., 2., 3.};
+  EXPECT_EQ(v.matrix(), (MatrixN<3, 1>(1., 2., 3.)));
+  EXPECT_EQ(Vector3(v.matrix() * 2.), Vector3(2., 4., 6.));
+  const Matrix3 m{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  EXPECT_EQ(Matrix3(m.matrix()), m);
+  EXPECT_EQ(Vector3(m.matrix().product(v.matrix())), m * v);
+  EXPECT_EQ(sizeof(Vector3), 3 * sizeof(double));
+
+  // Single precision types come for free.
+  const MatrixN<3, 1, float> f{1.f, 2.f, 3.f};
+  EXPECT_EQ(f * 2.f, (MatrixN<3, 1, float>(2.f, 4.f, 6.f)));
+
+  constexpr Matrix2 kConstant{1., 2., 3., 4.};
+  static_assert(kConstant(1, 0) == 3., "MatrixN is a literal type");
+  static_assert(kConstant.at(0, 1) == 2., "MatrixN is a literal type");
+
+  std::stringstream ss;
+  ss << m1;
+  EXPECT_EQ(ss.str(), "[[1, 2], [3, 4]]");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
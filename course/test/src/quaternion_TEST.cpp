@@ -0,0 +1,128 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include <isometry/isometry.hpp>
+#include <isometry/quaternion.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+testing::AssertionResult areAlmostEqual(const Matrix3 &obj1,
+                                        const Matrix3 &obj2,
+                                        const double tolerance) {
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      if (std::abs(obj1[i][j] - obj2[i][j]) > tolerance) {
+        return testing::AssertionFailure() << obj1 << " != " << obj2;
+      }
+    }
+  }
+  return testing::AssertionSuccess();
+}
+
+GTEST_TEST(QuaternionTest, QuaternionFullTests) {
+  const double kTolerance{1e-12};
+  const Quaternion q1{Quaternion::fromAxisAngle(Vector3::kUnitZ, M_PI / 2.)};
+  const Quaternion q2{Quaternion::fromAxisAngle(Vector3{1., 1., 0.}, 0.7)};
+
+  EXPECT_EQ(Quaternion(), Quaternion::kIdentity);
+  EXPECT_EQ(q1, Quaternion(std::sqrt(.5), 0., 0., std::sqrt(.5)));
+  EXPECT_NEAR(q2.norm(), 1., kTolerance);
+  EXPECT_EQ(q1 * Vector3::kUnitX, Vector3::kUnitY);
+  EXPECT_EQ(q1.rotate(Vector3{1., 2., 3.}), Vector3(-2., 1., 3.));
+  EXPECT_EQ(q1 * q1.conjugate(), Quaternion::kIdentity);
+  EXPECT_EQ(q1 + q1, q1 * 2.);
+  EXPECT_EQ(q1 - q1, Quaternion(0., 0., 0., 0.));
+  EXPECT_EQ(2. * q1, q1 * 2.);
+  EXPECT_NEAR(q1.dot(q1), 1., kTolerance);
+  EXPECT_EQ((q1 * 3.).normalized(), q1);
+  EXPECT_EQ(q1.vec(), Vector3(0., 0., std::sqrt(.5)));
+  EXPECT_ANY_THROW(Quaternion::fromAxisAngle(Vector3::kZero, 1.));
+
+  // Matches the matrix representation, in both directions.
+  const Matrix3 r1{Isometry::rotateAround(Vector3::kUnitZ, M_PI / 2.)
+                       .rotation()};
+  const Matrix3 r2{Isometry::rotateAround(Vector3{1., 1., 0.}, 0.7)
+                       .rotation()};
+  EXPECT_TRUE(areAlmostEqual(q1.toRotationMatrix(), r1, kTolerance));
+  EXPECT_TRUE(areAlmostEqual(q2.toRotationMatrix(), r2, kTolerance));
+  EXPECT_TRUE(areAlmostEqual((q1 * q2).toRotationMatrix(), r1.product(r2),
+                             kTolerance));
+  EXPECT_EQ(q2 * Vector3(1., -2., 3.), r2 * Vector3(1., -2., 3.));
+  // Exercises every branch of Shepperd's method.
+  const Isometry rotations[]{
+      Isometry::fromEulerAngles(0.1, 0.2, 0.3),
+      Isometry::rotateAround(Vector3::kUnitX, 3.),
+      Isometry::rotateAround(Vector3::kUnitY, 3.),
+      Isometry::rotateAround(Vector3::kUnitZ, 3.),
+      Isometry::rotateAround(Vector3{1., -1., 2.}, M_PI)};
+  for (const Isometry &rotation : rotations) {
+    const Quaternion q{Quaternion::fromRotationMatrix(rotation.rotation())};
+    EXPECT_NEAR(q.norm(), 1., kTolerance);
+    EXPECT_TRUE(areAlmostEqual(q.toRotationMatrix(), rotation.rotation(),
+                               kTolerance));
+  }
+
+  std::stringstream ss;
+  ss << Quaternion(1., 2., 3., 4.);
+  EXPECT_EQ(ss.str(), "(w: 1, x: 2, y: 3, z: 4)");
+}
+
+GTEST_TEST(QuaternionTest, QuaternionIsometryFullTests) {
+  const double kTolerance{1e-12};
+  const Isometry i1{Vector3{1., 2., 3.},
+                    Isometry::fromEulerAngles(0.3, -0.2, 1.1).rotation()};
+  const Isometry i2{Vector3{-1., 0.5, 2.},
+                    Isometry::fromEulerAngles(-1., 0.4, 2.).rotation()};
+  const QuaternionIsometry q1{i1};
+  const QuaternionIsometry q2{i2};
+  const Vector3 p{0.5, -4., 2.};
+
+  EXPECT_EQ(QuaternionIsometry(), QuaternionIsometry(Isometry::kIdentity));
+  EXPECT_EQ(q1.translation(), i1.translation());
+  EXPECT_TRUE(areAlmostEqual(q1.rotationMatrix(), i1.rotation(), kTolerance));
+  EXPECT_EQ(q1.toIsometry(), i1);
+  EXPECT_EQ(q1 * p, i1 * p);
+  EXPECT_EQ(q1.transform(p), i1.transform(p));
+  EXPECT_EQ(q1.inverse() * (q1 * p), p);
+  EXPECT_EQ(q1.inverse().toIsometry(), i1.inverse());
+  EXPECT_EQ((q1 * q2).toIsometry(), i1 * i2);
+  EXPECT_EQ(q1.compose(q2) * p, i1 * (i2 * p));
+  EXPECT_EQ(q1 * q1.inverse(), QuaternionIsometry());
+  // q and -q are the same rotation.
+  EXPECT_EQ(QuaternionIsometry(q1.translation(), q1.rotation() * -1.), q1);
+  EXPECT_NE(q1, q2);
+
+  QuaternionIsometry q3{q1};
+  q3 *= q2;
+  EXPECT_EQ(q3, q1 * q2);
+  QuaternionIsometry scaled{q1.translation(), q1.rotation() * 1.5};
+  EXPECT_NEAR(scaled.normalize().rotation().norm(), 1., kTolerance);
+  EXPECT_EQ(scaled, q1);
+  EXPECT_EQ(sizeof(QuaternionIsometry), 7 * sizeof(double));
+
+  std::stringstream ss;
+  ss << QuaternionIsometry();
+  EXPECT_EQ(ss.str(), "[T: (x: 0, y: 0, z: 0), Q: (w: 1, x: 0, y: 0, z: 0)]");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
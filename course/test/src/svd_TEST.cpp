@@ -0,0 +1,118 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+#include <isometry/svd.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+testing::AssertionResult areAlmostEqual(const Matrix3 &obj1,
+                                        const Matrix3 &obj2,
+                                        const double tolerance) {
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      if (std::abs(obj1[i][j] - obj2[i][j]) > tolerance) {
+        return testing::AssertionFailure() << obj1 << " != " << obj2;
+      }
+    }
+  }
+  return testing::AssertionSuccess();
+}
+
+Matrix3 diagonal(const Vector3 &values) {
+  return {values.x(), 0., 0., 0., values.y(), 0., 0., 0., values.z()};
+}
+
+Matrix3 recompose(const SVD3 &decomposition) {
+  return decomposition.u.product(diagonal(decomposition.s))
+      .product(decomposition.v.transpose());
+}
+
+testing::AssertionResult isRotation(const Matrix3 &matrix,
+                                    const double tolerance) {
+  if (!areAlmostEqual(matrix.product(matrix.transpose()), Matrix3::kIdentity,
+                      tolerance) ||
+      std::abs(matrix.det() - 1.) > tolerance) {
+    return testing::AssertionFailure() << matrix << " is not a rotation";
+  }
+  return testing::AssertionSuccess();
+}
+
+GTEST_TEST(SVDTest, SVDFullTests) {
+  const double kTolerance{1e-12};
+  const std::vector<Matrix3> matrices{
+      Matrix3{1., 2., 3., 4., 5., 6., 7., 8., 10.},
+      Matrix3{1., 2., 3., 4., 5., 6., 7., 8., 9.},
+      Matrix3{-2., 0.5, 0., 0.25, 3., -1., 4., 0., 0.},
+      Matrix3{0., 0., 1., 0., 1., 0., 1., 0., 0.},
+      Matrix3::kIdentity * 3.,
+      Matrix3::kOnes,
+      Matrix3::kZero,
+  };
+
+  std::vector<SVD3> batch(matrices.size());
+  svd(matrices.data(), batch.data(), matrices.size());
+
+  for (std::size_t i = 0; i < matrices.size(); ++i) {
+    const SVD3 fast = svd(matrices[i]);
+    EXPECT_TRUE(areAlmostEqual(recompose(fast), matrices[i], kTolerance));
+    EXPECT_TRUE(isRotation(fast.u, kTolerance));
+    EXPECT_TRUE(isRotation(fast.v, kTolerance));
+    EXPECT_GE(fast.s.x(), fast.s.y());
+    EXPECT_GE(fast.s.y(), std::abs(fast.s.z()));
+    EXPECT_NEAR(fast.s.x() * fast.s.y() * fast.s.z(), matrices[i].det(),
+                kTolerance);
+    EXPECT_TRUE(areAlmostEqual(batch[i].u, fast.u, 0.));
+    EXPECT_EQ(batch[i].s, fast.s);
+
+    const SVD3 reference = jacobiSvd(matrices[i]);
+    EXPECT_TRUE(areAlmostEqual(recompose(reference), matrices[i], kTolerance));
+    EXPECT_NEAR(reference.s.x(), fast.s.x(), kTolerance);
+    EXPECT_NEAR(reference.s.y(), fast.s.y(), kTolerance);
+    EXPECT_NEAR(reference.s.z(), fast.s.z(), kTolerance);
+  }
+
+  // Projects a drifted rotation back onto SO(3).
+  const double c{std::cos(0.3)};
+  const double s{std::sin(0.3)};
+  const Matrix3 rotation{c, -s, 0., s, c, 0., 0., 0., 1.};
+  const Matrix3 drifted = rotation + Matrix3{1e-6, 0., -2e-6, 0., 3e-6, 0.,
+                                             1e-6, 0., 0.};
+  EXPECT_TRUE(isRotation(nearestRotation(drifted), kTolerance));
+  EXPECT_TRUE(areAlmostEqual(nearestRotation(drifted), rotation, 1e-5));
+  EXPECT_TRUE(areAlmostEqual(nearestRotation(rotation), rotation, kTolerance));
+
+  // Recovers a rotation from point correspondences.
+  const Matrix3 r{0., -1., 0., 0., 0., -1., 1., 0., 0.};
+  const std::vector<Vector3> source{Vector3{1., 0., 0.}, Vector3{0., 2., 0.},
+                                    Vector3{0., 0., 3.}, Vector3{1., 1., 1.}};
+  std::vector<Vector3> target;
+  for (const Vector3 &point : source) {
+    target.push_back(r * point + Vector3{5., -1., 2.});
+  }
+  EXPECT_TRUE(areAlmostEqual(
+      fitRotation(source.data(), target.data(), source.size()), r,
+      kTolerance));
+  EXPECT_ANY_THROW(fitRotation(source.data(), target.data(), 0));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
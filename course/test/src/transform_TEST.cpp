@@ -0,0 +1,172 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <isometry/transform.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+// A lidar return: position plus an extra field, as in a typical scan.
+struct Point {
+  double xyz[3];
+  float intensity;
+};
+
+GTEST_TEST(TransformTest, TransformFullTests) {
+  const Isometry isometry{Vector3{1., -2., 0.5},
+                          Isometry::fromEulerAngles(0.3, -0.2, 1.1)
+                              .rotation()};
+  const std::size_t kCount{2 * kMinParallelPoints + 3};
+  std::vector<Vector3> points;
+  std::vector<Vector3> expected;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    const double t = static_cast<double>(i) * 1e-3;
+    points.emplace_back(std::cos(t), std::sin(t), t);
+    expected.push_back(isometry * points.back());
+  }
+
+  // Contiguous Vector3.
+  for (std::size_t threads : {1u, 3u}) {
+    std::vector<Vector3> results(kCount);
+    transform(isometry, points.data(), results.data(), kCount, threads);
+    EXPECT_EQ(results, expected);
+    results = points;
+    transformInPlace(isometry, results.data(), kCount, threads);
+    EXPECT_EQ(results, expected);
+  }
+
+  // Position fields inside a larger struct, and packed xyz.
+  std::vector<Point> scan(kCount);
+  std::vector<double> packed(3 * kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      scan[i].xyz[j] = points[i][j];
+    }
+    scan[i].intensity = 7.f;
+  }
+  transform(isometry, {scan[0].xyz, kCount, sizeof(Point)},
+            {packed.data(), kCount, 3 * sizeof(double)}, 2);
+  transformInPlace(isometry, {scan[0].xyz, kCount, sizeof(Point)}, 2);
+  for (std::size_t i = 0; i < kCount; i += 101) {
+    EXPECT_EQ(Vector3(scan[i].xyz[0], scan[i].xyz[1], scan[i].xyz[2]),
+              expected[i]);
+    EXPECT_EQ(Vector3(packed[3 * i], packed[3 * i + 1], packed[3 * i + 2]),
+              expected[i]);
+    EXPECT_EQ(scan[i].intensity, 7.f);
+  }
+
+  // Structure of arrays.
+  std::vector<double> xs(kCount);
+  std::vector<double> ys(kCount);
+  std::vector<double> zs(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    xs[i] = points[i].x();
+    ys[i] = points[i].y();
+    zs[i] = points[i].z();
+  }
+  std::vector<double> out_xs(kCount);
+  std::vector<double> out_ys(kCount);
+  std::vector<double> out_zs(kCount);
+  transform(isometry, {xs.data(), ys.data(), zs.data(), kCount},
+            {out_xs.data(), out_ys.data(), out_zs.data(), kCount});
+  transformInPlace(isometry, {xs.data(), ys.data(), zs.data(), kCount}, 4);
+  for (std::size_t i = 0; i < kCount; i += 101) {
+    EXPECT_EQ(Vector3(out_xs[i], out_ys[i], out_zs[i]), expected[i]);
+    EXPECT_EQ(Vector3(xs[i], ys[i], zs[i]), expected[i]);
+  }
+  // Outputs over other input coordinates.
+  for (std::size_t i = 0; i < kCount; ++i) {
+    xs[i] = points[i].x();
+    ys[i] = points[i].y();
+    zs[i] = points[i].z();
+  }
+  transform(isometry, {xs.data(), ys.data(), zs.data(), kCount},
+            {ys.data(), zs.data(), xs.data(), kCount});
+  for (std::size_t i = 0; i < kCount; i += 101) {
+    EXPECT_EQ(Vector3(ys[i], zs[i], xs[i]), expected[i]);
+  }
+
+  EXPECT_THROW(transform(isometry, {xs.data(), ys.data(), zs.data(), kCount},
+                         {out_xs.data(), out_ys.data(), out_zs.data(), 1}),
+               std::invalid_argument);
+  EXPECT_THROW(transform(isometry, {packed.data(), 2, 3 * sizeof(double)},
+                         {packed.data(), 1, 3 * sizeof(double)}),
+               std::invalid_argument);
+  transform(isometry, points.data(), nullptr, 0);
+}
+
+GTEST_TEST(TransformTest, InverseTransformFullTests) {
+  const Isometry isometry{Vector3{1., -2., 0.5},
+                          Isometry::fromEulerAngles(0.3, -0.2, 1.1)
+                              .rotation()};
+  const Isometry inverse{isometry.inverse()};
+  const std::size_t kCount{kMinParallelPoints + 5};
+  std::vector<Vector3> points;
+  std::vector<Vector3> expected;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    const double t = static_cast<double>(i) * 1e-3;
+    points.emplace_back(std::cos(t), t, std::sin(t));
+    expected.push_back(inverse * points.back());
+  }
+
+  std::vector<Vector3> results(kCount);
+  inverseTransform(isometry, points.data(), results.data(), kCount, 2);
+  EXPECT_EQ(results, expected);
+  transformInPlace(isometry, results.data(), kCount);
+  EXPECT_EQ(results, points);
+  results = points;
+  inverseTransformInPlace(isometry, results.data(), kCount);
+  EXPECT_EQ(results, expected);
+
+  std::vector<Point> scan(kCount);
+  std::vector<double> xs(kCount);
+  std::vector<double> ys(kCount);
+  std::vector<double> zs(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      scan[i].xyz[j] = points[i][j];
+    }
+    xs[i] = points[i].x();
+    ys[i] = points[i].y();
+    zs[i] = points[i].z();
+  }
+  std::vector<double> packed(3 * kCount);
+  inverseTransform(isometry, {scan[0].xyz, kCount, sizeof(Point)},
+                   {packed.data(), kCount, 3 * sizeof(double)});
+  inverseTransformInPlace(isometry, {scan[0].xyz, kCount, sizeof(Point)});
+  std::vector<double> out_xs(kCount);
+  std::vector<double> out_ys(kCount);
+  std::vector<double> out_zs(kCount);
+  inverseTransform(isometry, {xs.data(), ys.data(), zs.data(), kCount},
+                   {out_xs.data(), out_ys.data(), out_zs.data(), kCount});
+  inverseTransformInPlace(isometry,
+                          {xs.data(), ys.data(), zs.data(), kCount}, 2);
+  for (std::size_t i = 0; i < kCount; i += 101) {
+    EXPECT_EQ(Vector3(scan[i].xyz[0], scan[i].xyz[1], scan[i].xyz[2]),
+              expected[i]);
+    EXPECT_EQ(Vector3(packed[3 * i], packed[3 * i + 1], packed[3 * i + 2]),
+              expected[i]);
+    EXPECT_EQ(Vector3(out_xs[i], out_ys[i], out_zs[i]), expected[i]);
+    EXPECT_EQ(Vector3(xs[i], ys[i], zs[i]), expected[i]);
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ * Author: Jose Tomas Lorente, 2020
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include <isometry/transform_buffer.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+// Moves along x at 1 m/s while turning around z at 0.1 rad/s.
+Isometry poseAt(const double stamp) {
+  return Isometry::fromTranslation({stamp, 0., 0.}) *
+         Isometry::rotateAround(Vector3::kUnitZ, 0.1 * stamp);
+}
+
+GTEST_TEST(TransformBufferTest, TransformBufferFullTests) {
+  EXPECT_THROW(TransformBuffer(0), std::invalid_argument);
+  EXPECT_THROW(TransformBuffer(4, 0.), std::invalid_argument);
+
+  TransformBuffer buffer(4);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), 4u);
+  EXPECT_THROW(buffer.newest(), std::out_of_range);
+  EXPECT_THROW(buffer.lookup(0.), std::out_of_range);
+
+  for (int i = 0; i < 3; ++i) {
+    buffer.insert(i, poseAt(i));
+  }
+  EXPECT_EQ(buffer.size(), 3u);
+  EXPECT_EQ(buffer.oldest().stamp, 0.);
+  EXPECT_EQ(buffer.newest().stamp, 2.);
+  EXPECT_THROW(buffer.insert(2., poseAt(2.)), std::invalid_argument);
+  EXPECT_THROW(buffer.insert(1., poseAt(1.)), std::invalid_argument);
+
+  EXPECT_EQ(buffer.find(0.), 0u);
+  EXPECT_EQ(buffer.find(0.5), 0u);
+  EXPECT_EQ(buffer.find(1.), 1u);
+  EXPECT_EQ(buffer.find(10.), 2u);
+  EXPECT_THROW(buffer.find(-0.1), std::out_of_range);
+
+  EXPECT_EQ(buffer.lookup(1.), poseAt(1.));
+  EXPECT_EQ(buffer.lookup(2.), poseAt(2.));
+  EXPECT_EQ(buffer.lookup(1.25), poseAt(1.25));
+  EXPECT_EQ(buffer.lookup(0.5, Interpolation::kNlerp), poseAt(0.5));
+  EXPECT_THROW(buffer.lookup(2.1), std::out_of_range);
+  EXPECT_THROW(buffer.lookup(-0.1), std::out_of_range);
+
+  // A full ring overwrites the oldest sample, wrapping around storage.
+  for (int i = 3; i < 10; ++i) {
+    buffer.insert({static_cast<double>(i), poseAt(i)});
+    EXPECT_EQ(buffer.newest().stamp, i);
+  }
+  EXPECT_EQ(buffer.size(), 4u);
+  for (std::size_t i = 0; i < buffer.size(); ++i) {
+    EXPECT_EQ(buffer[i].stamp, 6. + i);
+    EXPECT_EQ(buffer[i].isometry, poseAt(6. + i));
+  }
+  EXPECT_EQ(buffer.find(8.5), 2u);
+  EXPECT_EQ(buffer.lookup(8.5), poseAt(8.5));
+  EXPECT_THROW(buffer.lookup(5.5), std::out_of_range);
+
+  // Retention drops the samples too old, always keeping the newest one.
+  buffer.setRetention(1.5);
+  EXPECT_EQ(buffer.retention(), 1.5);
+  EXPECT_EQ(buffer.size(), 2u);
+  EXPECT_EQ(buffer.oldest().stamp, 8.);
+  buffer.insert(20., poseAt(20.));
+  EXPECT_EQ(buffer.size(), 1u);
+  EXPECT_EQ(buffer.lookup(20.), poseAt(20.));
+  EXPECT_THROW(buffer.setRetention(-1.), std::invalid_argument);
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  buffer.insert(0., poseAt(0.));
+  EXPECT_EQ(buffer.newest().stamp, 0.);
+}
+
+GTEST_TEST(TransformBufferTest, ExtrapolationFullTests) {
+  const Twist twist{Vector3(1., 0.2, 0.), Vector3(0., 0.1, 0.5)};
+  TransformBuffer buffer(100);
+  buffer.insert(0., Isometry::kIdentity);
+  EXPECT_THROW(buffer.velocity(), std::out_of_range);
+  EXPECT_THROW(buffer.extrapolate(1.), std::out_of_range);
+
+  // Constant twist motion is predicted exactly, whatever the baseline.
+  for (int i = 1; i < 50; ++i) {
+    const double stamp{0.01 * i};
+    buffer.insert(stamp, expSE3(twist * stamp));
+  }
+  for (const double baseline : {0., 0.05, 0.1, 10.}) {
+    EXPECT_EQ(buffer.velocity(baseline), twist);
+    EXPECT_EQ(buffer.extrapolate(0.5, baseline), expSE3(twist * 0.5));
+    EXPECT_EQ(buffer.extrapolate(0.7, baseline), expSE3(twist * 0.7));
+  }
+  EXPECT_EQ(buffer.extrapolate(buffer.newest().stamp),
+            buffer.newest().isometry);
+  EXPECT_THROW(buffer.extrapolate(0.3), std::out_of_range);
+
+  // The velocity can be reused for many predictions.
+  const Twist velocity{buffer.velocity()};
+  EXPECT_EQ(extrapolate(buffer.newest(), velocity, 0.6), expSE3(twist * 0.6));
+
+  // A long baseline smooths out a noisy newest sample.
+  buffer.insert(0.5, expSE3(twist * 0.5) *
+                         Isometry::fromTranslation({0.01, 0., 0.}));
+  const double short_error{
+      (buffer.extrapolate(0.6).translation() -
+       expSE3(twist * 0.6).translation()).norm()};
+  const double long_error{
+      (buffer.extrapolate(0.6, 0.2).translation() -
+       expSE3(twist * 0.6).translation()).norm()};
+  EXPECT_LT(long_error, short_error / 5.);
+}
+
+GTEST_TEST(TransformBufferTest, BatchedLookupFullTests) {
+  TransformBuffer buffer(16);
+  for (int i = 0; i < 10; ++i) {
+    buffer.insert(i, poseAt(i));
+  }
+  // Several stamps per interval, some on samples, some skipping intervals.
+  const std::vector<double> stamps{0., 0.1, 0.2, 0.2, 1., 1.5, 1.7, 4.,
+                                   4.5, 8.9, 9.};
+  const std::vector<Vector3> points(stamps.size(), Vector3(1., -2., 0.5));
+  for (const Interpolation mode : {Interpolation::kScrew,
+                                   Interpolation::kSlerp,
+                                   Interpolation::kNlerp}) {
+    std::vector<Isometry> poses(stamps.size());
+    std::vector<Vector3> transformed(stamps.size());
+    buffer.lookup(stamps.data(), poses.data(), stamps.size(), mode);
+    buffer.transform(stamps.data(), points.data(), transformed.data(),
+                     stamps.size(), mode);
+    for (std::size_t i = 0; i < stamps.size(); ++i) {
+      EXPECT_EQ(poses[i], buffer.lookup(stamps[i], mode));
+      EXPECT_EQ(transformed[i], poses[i] * points[i]);
+    }
+  }
+  buffer.lookup(stamps.data(), nullptr, 0);
+
+  std::vector<Isometry> poses(3);
+  const std::vector<double> unsorted{1., 3., 2.};
+  EXPECT_THROW(buffer.lookup(unsorted.data(), poses.data(), 3),
+               std::invalid_argument);
+  const std::vector<double> late{1., 9., 9.5};
+  EXPECT_THROW(buffer.lookup(late.data(), poses.data(), 3),
+               std::out_of_range);
+  const std::vector<double> early{-1., 0., 1.};
+  EXPECT_THROW(buffer.lookup(early.data(), poses.data(), 3),
+               std::out_of_range);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -10,6 +10,7 @@
  */
 
 #include <cmath>
+#include <cstddef>
 #include <sstream>
 #include <string>
 
@@ -46,6 +47,10 @@ GTEST_TEST(Vector3Test, Vector3FullTests) {
   EXPECT_EQ(p * 2., Vector3(2., 4., 6.));
   EXPECT_EQ(q / 2., Vector3(2., 2.5, 3.));
   EXPECT_EQ(2 * q, Vector3(8., 10., 12.));
+  EXPECT_EQ(p * 0.5, Vector3(.5, 1., 1.5));
+  EXPECT_EQ(0.5 * q, Vector3(2., 2.5, 3.));
+  EXPECT_EQ(p * std::size_t{3}, Vector3(3., 6., 9.));
+  EXPECT_EQ(-2L * p, Vector3(-2., -4., -6.));
   EXPECT_NEAR(p.dot(q), 32., kTolerance);
 
   EXPECT_EQ(r += q, Vector3(5., 6., 7.));